@@ -0,0 +1,64 @@
+/**
+ * @file ClockService.h
+ * @brief Header file for disciplining esp_timer to UTC from GNSS time and the PPS pulse.
+ *
+ * The clock is a line through the latest reference point: a local
+ * esp_timer_get_time() value, the UTC it corresponds to, and the measured
+ * frequency error of the local oscillator. On boards with GPS_PPS_PIN wired,
+ * the PPS interrupt stamps the start of every UTC second and the GNSS message
+ * that follows says which second it was; each edge re-anchors the line and
+ * the spacing of the edges gives the frequency error. Without PPS, or while
+ * it is missing, the time in the GNSS messages is taken at the moment the
+ * message was parsed, which is only good to the module's output delay.
+ *
+ * toUtc() converts any esp_timer stamp. The error it reports is that of the
+ * reference point plus the drift allowed since, so it grows in holdover.
+ */
+
+#pragma once
+#include <Arduino.h>
+#include <freertos/FreeRTOS.h>
+#include <esp_timer.h>
+#include <algorithm>
+#include "packet.pb.h"
+#include "LoraBoards.h"
+
+class ClockService
+{
+public:
+    static constexpr uint32_t PPS_ERROR_US = 5;           ///< PPS interrupt latency and module pulse accuracy
+    static constexpr uint32_t MESSAGE_ERROR_US = 100000;  ///< Output delay of a GNSS message, bounded
+    static constexpr int64_t PPS_PAIR_US = 1100000;       ///< Longest a message may follow the edge it is paired with
+    static constexpr int64_t STEP_US = 1000;              ///< Phase errors beyond this step the clock instead of updating the frequency
+    static constexpr float FREQUENCY_GAIN = 0.25f;        ///< Weight of each new frequency measurement
+    static constexpr uint32_t HOLDOVER_PPM = 50;          ///< Drift allowed for an oscillator not yet measured
+    static constexpr uint32_t MEASURED_PPM = 2;           ///< Drift allowed once the frequency error is measured
+
+    ClockService();
+    void begin();
+    void onGnssTime(int64_t utcUs, int64_t localUs);
+    ClockSource toUtc(int64_t localUs, uint64_t &utcUs, uint32_t &errorUs) const;
+    uint64_t nowUs() const;
+    void fillStats(Stats &stats) const;
+
+    static int64_t utcMicros(uint16_t year, uint8_t month, uint8_t day, uint8_t hour, uint8_t minute, uint8_t second, int32_t nanos);
+
+private:
+    static ClockService *instance; ///< Singleton instance, for the PPS ISR
+    static void IRAM_ATTR ppsISR();
+
+    mutable portMUX_TYPE mMux = portMUX_INITIALIZER_UNLOCKED; ///< Guards the PPS stamp and the reference point
+    volatile int64_t mPpsUs = 0;        ///< esp_timer_get_time() of the latest PPS edge
+    volatile uint32_t mPpsEdges = 0;    ///< PPS edges seen
+    int64_t mPairedPpsUs = 0;           ///< PPS edge last used as a reference point, GPS task only
+
+    ClockSource mSource = ClockSource_CLOCK_LOCAL; ///< What the reference point came from
+    int64_t mBaseLocalUs = 0;           ///< esp_timer_get_time() of the reference point
+    int64_t mBaseUtcUs = 0;             ///< UTC of the reference point, microseconds since 1970
+    uint32_t mBaseErrorUs = 0;          ///< Error of the reference point
+    double mFrequency = 0;              ///< Local oscillator error, UTC seconds per local second minus 1
+    bool mFrequencyKnown = false;       ///< mFrequency has been measured from PPS edges
+    uint32_t mSteps = 0;                ///< Times the clock was stepped rather than steered
+
+    void discipline(int64_t localUs, int64_t utcUs, uint32_t errorUs, ClockSource source);
+};
@@ -0,0 +1,81 @@
+/**
+ * @file FrameCodec.h
+ * @brief Header file for framing protobuf messages on the host serial link.
+ *
+ * Two wire formats are supported:
+ *  - Delimited (legacy): <START>payload<END>
+ *  - COBS: 0x00, COBS(payload || CRC16 little-endian), 0x00
+ */
+
+#pragma once
+#include <Arduino.h>
+#include "packet.pb.h"
+
+class FrameCodec
+{
+public:
+    static constexpr const char *START_DELIMITER = "<START>";
+    static constexpr const char *END_DELIMITER = "<END>";
+    static constexpr size_t START_LEN = 7; ///< Length of the start delimiter
+    static constexpr size_t END_LEN = 5;   ///< Length of the end delimiter
+    static constexpr size_t CRC_LEN = 2;   ///< Length of the COBS frame CRC16
+
+    /// Upper bound on the framed size of a payload of the given length in either mode.
+    static constexpr size_t maxEncodedSize(size_t length)
+    {
+        return length + START_LEN + END_LEN + CRC_LEN + length / 254 + 2;
+    }
+
+    static Framing mode() { return sMode; }
+    static void setMode(Framing mode) { sMode = mode; }
+
+    static uint16_t crc16(const uint8_t *data, size_t length, uint16_t crc = 0xFFFF);
+    static size_t encode(Framing mode, const uint8_t *data, size_t length, uint8_t *out, size_t capacity);
+
+private:
+    static volatile Framing sMode; ///< Framing currently used on the link
+};
+
+class FrameDecoder
+{
+public:
+    FrameDecoder(uint8_t *buffer, size_t capacity);
+
+    bool push(uint8_t byte);
+    void reset();
+    void setBuffer(uint8_t *buffer) { mBuffer = buffer; }
+
+    const uint8_t *data() const { return mBuffer; }
+    size_t length() const { return mLength; }
+
+    uint32_t frameCount() const { return mFrames; }
+    uint32_t crcErrorCount() const { return mCrcErrors; }
+    uint32_t overflowCount() const { return mOverflows; }
+    uint32_t malformedCount() const { return mMalformed; }
+
+private:
+    uint8_t *mBuffer;   ///< Destination for the decoded payload
+    size_t mCapacity;   ///< Capacity of the destination buffer
+    size_t mIndex = 0;  ///< Write position in the destination buffer
+    size_t mLength = 0; ///< Length of the last completed frame
+
+    Framing mMode = Framing_FRAMING_DELIMITED; ///< Framing of the frame currently being decoded
+    bool mInFrame = false;                     ///< A delimited frame is being collected
+    bool mDiscard = false;                     ///< Skipping bytes until the next COBS delimiter
+    size_t mStartMatch = 0;                    ///< Matched prefix length of the start delimiter
+    bool mAtBoundary = true;                   ///< No COBS byte of the current frame has broken a start delimiter
+    size_t mEndMatch = 0;                      ///< Matched prefix length of the end delimiter
+    uint8_t mCobsRemaining = 0;                ///< Data bytes left in the current COBS block
+    bool mCobsPendingZero = false;             ///< Current COBS block ends in an implicit zero
+
+    uint32_t mFrames = 0;    ///< Frames accepted
+    uint32_t mCrcErrors = 0; ///< COBS frames rejected by the CRC check
+    uint32_t mOverflows = 0; ///< Frames dropped because they exceeded the buffer
+    uint32_t mMalformed = 0; ///< COBS frames with a truncated block
+
+    static size_t advanceMatch(size_t matched, uint8_t byte, const char *delimiter);
+    bool pushDelimited(uint8_t byte);
+    bool pushCobs(uint8_t byte);
+    bool append(uint8_t byte);
+    void beginFrame();
+};
@@ -0,0 +1,68 @@
+/**
+ * @file GnssConfig.h
+ * @brief Header file for negotiating the fastest fix rate and output protocol the GNSS module supports.
+ *
+ * Runs once at start-up, before the GPS task takes the UART. A module that
+ * acknowledges UBX is a u-blox: the UART is moved to FAST_BAUD, NAV-PVT is
+ * enabled and NMEA output turned off, so an epoch costs one ~100-byte binary
+ * frame instead of several NMEA sentences. A u-blox too old for NAV-PVT keeps
+ * NMEA, trimmed to GGA and RMC. Anything else that talks NMEA is taken for a
+ * CASIC module such as the L76K and configured with $PCAS commands.
+ *
+ * The rate is then negotiated from the fastest in the table down: a rate is
+ * only tried if the UART can carry it, and only kept if the module actually
+ * delivers at least RATE_TOLERANCE_PCT of the expected epochs, since some
+ * modules accept a rate they cannot sustain.
+ */
+
+#pragma once
+#include <Arduino.h>
+#include "UbxParser.h"
+
+class GnssConfig
+{
+public:
+    /// Output protocol the GPS task parses.
+    enum Protocol : uint8_t
+    {
+        NMEA, ///< NMEA sentences, parsed with TinyGPS++
+        UBX,  ///< UBX NAV-PVT frames, parsed with UbxParser
+    };
+
+    static constexpr uint32_t FAST_BAUD = 115200;      ///< UART rate asked of the module for high fix rates
+    static constexpr uint32_t CASIC_DEFAULT_BAUD = 9600; ///< Factory UART rate of CASIC modules
+    static constexpr uint32_t ACK_TIMEOUT_MS = 300;    ///< Wait for a UBX acknowledgement
+    static constexpr uint32_t SETTLE_MS = 200;         ///< Wait after a port or rate change before measuring
+    static constexpr uint32_t MIN_MEASURE_MS = 1000;   ///< Shortest window over which a rate is measured
+    static constexpr uint32_t MEASURE_EPOCHS = 5;      ///< Epochs a measurement window spans at least
+    static constexpr uint32_t RATE_TOLERANCE_PCT = 80; ///< Share of the expected epochs a rate must deliver
+    static constexpr uint32_t LINK_LOAD_PCT = 70;      ///< Share of the UART a rate may use
+    static constexpr size_t UBX_EPOCH_BYTES = 100;     ///< One NAV-PVT frame
+    static constexpr size_t NMEA_EPOCH_BYTES = 160;    ///< One GGA and one RMC sentence
+
+    explicit GnssConfig(HardwareSerial &serial);
+    bool negotiate();
+    Protocol protocol() const { return mProtocol; }
+    uint32_t intervalMs() const { return mIntervalMs; }
+    const char *moduleName() const { return mModule; }
+
+private:
+    HardwareSerial &mSerial;           ///< Reference to the GPS serial interface
+    Protocol mProtocol = NMEA;         ///< Protocol the module was left sending
+    uint32_t mIntervalMs = 1000;       ///< Negotiated navigation interval
+    const char *mModule = "none";      ///< Module family found
+    bool mUblox = false;               ///< The module acknowledges UBX
+
+    bool configureUblox();
+    bool configureCasic();
+    bool negotiateRate();
+    bool setRate(uint32_t intervalMs);
+    bool setUbxRate(uint32_t intervalMs);
+    bool setCasicRate(uint32_t intervalMs);
+    bool sendUbx(uint8_t msgClass, uint8_t msgId, const uint8_t *payload, uint16_t length, bool waitAck = true);
+    bool setUbxPort(uint32_t baud, uint16_t outProtocols, bool waitAck);
+    void sendNmea(const char *body);
+    bool linkCarries(uint32_t intervalMs);
+    uint32_t countEpochs(uint32_t windowMs);
+    void discardInput();
+};
@@ -0,0 +1,84 @@
+/**
+ * @file GpsManager.h
+ * @brief Header file for reading the GPS receiver in the background and sharing the latest fix.
+ *
+ * At start-up GnssConfig negotiates the fastest fix rate the module sustains
+ * and, on a u-blox, switches it to UBX NAV-PVT output. A low-priority task then
+ * drains the GPS UART every POLL_MS and feeds UbxParser or TinyGPS++, so the
+ * driver's RX buffer never overflows and no sentence is torn, however long the
+ * radio side goes without a log. Each completed sentence or frame that updates
+ * the position publishes a snapshot under a sequence lock: the task bumps the
+ * sequence to odd, writes, and bumps it back to even, all inside a critical
+ * section so it cannot be preempted half way. Readers copy the snapshot
+ * without taking a lock and retry if the sequence moved or was odd, which
+ * makes filling a Gps a constant-time copy from any task. Every epoch with a
+ * valid UTC time is also handed to ClockService.
+ */
+
+#pragma once
+#include <Arduino.h>
+#include <atomic>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include <TinyGPS++.h>
+#include "packet.pb.h"
+#include "GnssConfig.h"
+#include "UbxParser.h"
+#include "LatencyStats.h"
+#include "ClockService.h"
+
+class GpsManager
+{
+public:
+    static constexpr UBaseType_t TASK_PRIORITY = 1;   ///< Alongside the main loop; only the UART buffer is waiting
+    static constexpr BaseType_t TASK_CORE = 1;        ///< Away from the radio task
+    static constexpr uint32_t TASK_STACK_SIZE = 3072; ///< Both parsers work in place
+    static constexpr uint32_t POLL_MS = 10;           ///< UART drain interval, well inside the RX buffer at GPS baud rates
+    static constexpr uint32_t NO_FIX_AGE = UINT32_MAX; ///< Gps.fix_age_ms before the first fix
+    static constexpr uint32_t FIX_RATE_WINDOW_MS = 2000; ///< Window over which the achieved fix rate is measured
+
+    GpsManager(HardwareSerial &serial, ClockService &clock);
+    bool begin();
+    void read(Gps &gps) const;
+    void fillStats(Stats &stats) const;
+
+private:
+    /// Latest fix, published under mSequence.
+    struct Fix
+    {
+        int32_t latitudeE7 = 0;       ///< 1e-7 degrees, 0 before the first fix
+        int32_t longitudeE7 = 0;      ///< 1e-7 degrees, 0 before the first fix
+        uint32_t hdopCenti = 0;       ///< HDOP x 100, 0 if unknown
+        uint32_t speedCmS = 0;        ///< Ground speed
+        uint32_t courseCdeg = 0;      ///< Course over ground in 0.01 degrees
+        uint32_t satellites = 0;      ///< Satellites in use, 0 if unknown
+        uint32_t fixMs = 0;           ///< millis() when the position was last updated
+        bool valid = false;           ///< A position has been received
+        uint32_t sentences = 0;       ///< Sentences or frames that passed the checksum
+        uint32_t checksumErrors = 0;  ///< Those that failed it, e.g. torn by an overflow
+        float fixRateHz = 0;          ///< Position fixes per second over the last window
+        LatencyStats parseTime;       ///< UART read and parse time per position fix
+    };
+
+    HardwareSerial &mSerial;              ///< Reference to the GPS serial interface
+    ClockService &mClock;                 ///< Reference to the clock the GNSS time disciplines
+    GnssConfig mConfig;                   ///< Negotiated protocol and rate, fixed once the task runs
+    TinyGPSPlus mNmea;                    ///< NMEA parser in fast mode, only touched by the GPS task
+    UbxParser mUbx;                       ///< UBX parser, only touched by the GPS task
+    uint32_t mEpochTime = UINT32_MAX;     ///< NMEA time of the latest fix, to count GGA and RMC once
+    uint32_t mParseUs = 0;                ///< Parse time since the previous fix
+    uint32_t mWindowStartMs = 0;          ///< millis() when the fix rate window started
+    uint32_t mWindowFixes = 0;            ///< Fixes in the current window
+    TaskHandle_t mTaskHandle = nullptr;   ///< GPS task draining the UART
+    portMUX_TYPE mWriteMux = portMUX_INITIALIZER_UNLOCKED; ///< Keeps the GPS task from being preempted mid-publish
+    std::atomic<uint32_t> mSequence{0};   ///< Odd while mFix is being written
+    Fix mFix;                             ///< Latest fix, read through snapshot()
+
+    static void gpsTask(void *param);
+    static int32_t toE7(const RawDegrees &raw);
+    void drain();
+    bool drainNmea(Fix &fix, bool &epoch);
+    bool drainUbx(Fix &fix, bool &epoch);
+    void publish(const Fix &fix);
+    void snapshot(Fix &fix) const;
+};
@@ -0,0 +1,44 @@
+/**
+ * @file LatencyStats.h
+ * @brief Running min/mean/max and standard deviation accumulator for microsecond timing measurements.
+ */
+
+#pragma once
+#include <Arduino.h>
+#include <math.h>
+#include "packet.pb.h"
+
+struct LatencyStats
+{
+    uint32_t samples = 0;
+    uint32_t minUs = UINT32_MAX;
+    uint32_t maxUs = 0;
+    uint64_t sumUs = 0;
+    double meanUs = 0;   ///< Running mean for the variance (Welford), kept apart from sumUs
+    double sumSqDev = 0; ///< Sum of squared deviations from the running mean
+
+    void add(uint32_t us)
+    {
+        samples++;
+        sumUs += us;
+        if (us < minUs)
+            minUs = us;
+        if (us > maxUs)
+            maxUs = us;
+
+        double delta = us - meanUs;
+        meanUs += delta / samples;
+        sumSqDev += delta * (us - meanUs);
+    }
+
+    void reset() { *this = LatencyStats(); }
+
+    void fill(Latency &latency) const
+    {
+        latency.samples = samples;
+        latency.min_us = samples ? minUs : 0;
+        latency.mean_us = samples ? static_cast<uint32_t>(sumUs / samples) : 0;
+        latency.max_us = maxUs;
+        latency.stddev_us = samples > 1 ? static_cast<uint32_t>(sqrt(sumSqDev / (samples - 1)) + 0.5) : 0;
+    }
+};
@@ -0,0 +1,100 @@
+/**
+ * @file LinkAdapter.h
+ * @brief Header file for stepping the modulation along a ladder of settings from receiver feedback.
+ *
+ * Settings.ladder lists the rungs from the most robust (rung 0) to the fastest.
+ * Both ends start on rung 0. Every adapt_interval_ms the transmitter sends a
+ * POLL and listens briefly; the receiver answers with a FEEDBACK carrying how
+ * many packets it has received and their mean SNR. From that the transmitter
+ * works out the packet error rate and the SNR margin over the demodulation
+ * floor, and proposes a rung in its next POLL. The receiver switches once it
+ * has sent the FEEDBACK echoing the proposal; the transmitter switches when it
+ * hears that FEEDBACK. If either is lost, the transmitter falls back to rung 0
+ * after MAX_MISSED_POLLS unanswered polls and the receiver after LOST_POLLS
+ * intervals without a packet, so the two meet again on rung 0.
+ *
+ * Control payloads are FRAME_SIZE bytes starting with LINK_MAGIC; while
+ * adaptation is on, host payloads of that size and first byte are taken for
+ * control payloads.
+ */
+
+#pragma once
+#include <Arduino.h>
+#include "packet.pb.h"
+
+class LinkAdapter
+{
+public:
+    static constexpr uint8_t LINK_MAGIC = 0xC3;     ///< First byte of a link control payload
+    static constexpr uint8_t POLL = 1;              ///< Control payload asking the receiver for feedback
+    static constexpr uint8_t FEEDBACK = 2;          ///< Control payload answering a poll
+    static constexpr size_t FRAME_SIZE = 10;        ///< Size of every control payload
+    static constexpr uint32_t MAX_MISSED_POLLS = 3; ///< Unanswered polls before the transmitter falls back to rung 0
+    static constexpr uint32_t LOST_POLLS = 4;       ///< Poll intervals without a packet before the receiver falls back
+    static constexpr uint32_t UP_HOLD = 2;          ///< Consecutive feedbacks with room to spare before stepping up
+    static constexpr size_t MAX_RUNGS = sizeof(Settings::ladder) / sizeof(LinkRung); ///< Rungs that fit in Settings.ladder
+
+    /// Decoded control payload.
+    struct Frame
+    {
+        uint8_t type = 0;        ///< POLL or FEEDBACK
+        uint8_t rung = 0;        ///< Rung the sender is on
+        uint8_t next = 0;        ///< Rung proposed by the transmitter, echoed by the receiver
+        uint16_t sequence = 0;   ///< Poll number, echoed by the feedback
+        uint16_t count = 0;      ///< Packets sent (poll) or received (feedback) so far, wrapping
+        int8_t snrQuarterDb = 0; ///< Mean SNR since the previous feedback in 0.25 dB, feedback only
+        uint8_t rssiRaw = 0;     ///< Mean RSSI since the previous feedback as -2 * dBm, feedback only
+    };
+
+    static size_t writeFrame(const Frame &frame, uint8_t *payload);
+    static bool readFrame(const uint8_t *payload, size_t length, Frame &frame);
+    static float demodFloor(int32_t spreadingFactor);
+
+    void configure(const Settings &settings);
+    bool enabled() const { return mIntervalMs > 0 && mLadderCount > 0; }
+    uint32_t intervalMs() const { return mIntervalMs; }
+    uint8_t rung() const { return mRung; }
+    size_t rungCount() const { return mLadderCount; }
+    void applyRung(uint8_t rung, Settings &config) const;
+    void revertRung(uint8_t rung);
+    bool restart(uint32_t nowMs, LinkAdapt &decision);
+
+    void noteSent() { mSentTotal++; }
+    void makePoll(Frame &poll);
+    bool isFeedback(const Frame &frame) const { return frame.type == FEEDBACK && frame.sequence == mSequence; }
+    bool onFeedback(const Frame &feedback, LinkAdapt &decision);
+    bool onMissedFeedback(LinkAdapt &decision);
+
+    bool receive(const uint8_t *payload, size_t length, float snr, float rssi, uint32_t nowMs, Frame &poll);
+    bool answer(const Frame &poll, Frame &feedback, LinkAdapt &decision);
+    bool checkLost(uint32_t nowMs, LinkAdapt &decision);
+
+private:
+    LinkRung mLadder[MAX_RUNGS];    ///< Rungs from the settings, most robust first
+    size_t mLadderCount = 0;        ///< Number of rungs in mLadder
+    uint32_t mIntervalMs = 0;       ///< Poll interval, 0 disables adaptation
+    uint32_t mTargetPerPpm = 0;     ///< Highest packet error rate tolerated on a rung
+    float mMarginDb = 0;            ///< SNR margin over the demodulation floor a rung must keep
+    float mHysteresisDb = 0;        ///< Extra margin the next rung up must be predicted to have
+
+    uint8_t mRung = 0;              ///< Rung in use
+    uint8_t mNext = 0;              ///< Rung proposed to the receiver, mRung if none
+    AdaptReason mProposal = AdaptReason_ADAPT_START; ///< Why mNext was proposed
+    uint16_t mSequence = 0;         ///< Number of the latest poll
+    uint16_t mSentTotal = 0;        ///< Packets sent, wrapping, control payloads excluded
+    uint16_t mPollSent = 0;         ///< mSentTotal carried by the latest poll
+    bool mHaveBase = false;         ///< mBaseSent and mBaseReceived hold an answered poll
+    uint16_t mBaseSent = 0;         ///< mSentTotal of the previous answered poll
+    uint16_t mBaseReceived = 0;     ///< Receive count of the previous feedback
+    uint32_t mMissed = 0;           ///< Polls in a row without feedback
+    uint32_t mUpVotes = 0;          ///< Feedbacks in a row with room to step up
+
+    uint16_t mReceivedTotal = 0;    ///< Packets received, wrapping, control payloads excluded
+    float mSnrSum = 0;              ///< Sum of the SNR readings since the previous feedback
+    float mRssiSum = 0;             ///< Sum of the RSSI readings since the previous feedback
+    uint32_t mSignalCount = 0;      ///< Readings in mSnrSum and mRssiSum
+    uint32_t mHeardMs = 0;          ///< millis() of the latest packet received
+
+    void fillDecision(uint8_t rung, AdaptReason reason, bool applied, LinkAdapt &decision) const;
+    float predictMargin(uint8_t rung, float snr) const;
+};
@@ -0,0 +1,49 @@
+/**
+ * @file LinkManager.h
+ * @brief Header file for negotiating the host serial baud rate and answering link self-tests.
+ *
+ * A baud rate change is provisional until the host commits it. The host runs a
+ * LINK_TEST echo exchange at the new rate first; if it never commits, or the
+ * receive error count climbs past MAX_TEST_ERRORS, the device falls back to the
+ * rate it had before.
+ */
+
+#pragma once
+#include <Arduino.h>
+#include "packet.pb.h"
+#include "SerialTaskManager.h"
+#include "SerialTxManager.h"
+
+class LinkManager
+{
+public:
+    static constexpr uint32_t DEFAULT_BAUD_RATE = 115200; ///< Rate the port is opened with in setupBoards()
+    static constexpr uint32_t COMMIT_TIMEOUT_MS = 3000;   ///< Time the host has to commit a new rate
+    static constexpr uint32_t MAX_TEST_ERRORS = 8;        ///< Receive errors tolerated before falling back
+
+    LinkManager(SerialTaskManager &serialMgr, SerialTxManager &serialTx);
+
+    static bool isSupportedBaudRate(uint32_t baudRate);
+    void changeBaudRate(uint32_t baudRate);
+    void commitBaudRate();
+    void poll();
+    void echo(const LinkTest &test, size_t frameLength, uint32_t rxTimeUs);
+    uint32_t baudRate() const { return mBaudRate; }
+
+private:
+    SerialTaskManager &mSerialMgr; ///< Reference to the SerialTaskManager
+    SerialTxManager &mSerialTx;    ///< Reference to the SerialTxManager
+
+    uint32_t mBaudRate = DEFAULT_BAUD_RATE;     ///< Rate currently requested of the port
+    uint32_t mFallbackBaud = DEFAULT_BAUD_RATE; ///< Rate to return to if the change is not committed
+    bool mPending = false;                      ///< A baud rate change is waiting to be committed
+    uint32_t mDeadlineMs = 0;                   ///< millis() by which the change must be committed
+    uint32_t mErrorBase = 0;                    ///< Receive error count when the rate was changed
+
+    uint32_t mTestFrames = 0;  ///< LINK_TEST frames received at the current rate
+    uint64_t mTestBytes = 0;   ///< Frame bytes of those, excluding the first
+    uint32_t mFirstTestUs = 0; ///< Receive time of the first LINK_TEST frame
+    uint32_t mLastTestUs = 0;  ///< Receive time of the latest LINK_TEST frame
+
+    void apply(uint32_t baudRate);
+};
@@ -0,0 +1,67 @@
+/**
+ * @file ProbeTracker.h
+ * @brief Header file for the receiver side of the sequence-numbered probe test.
+ *
+ * The transmitter sends PATTERN_PROBE payloads: PROBE_MAGIC, a little-endian
+ * uint32 sequence number and the uint64 ClockService time at which the
+ * transmission was started. The receiver tracks loss, duplicates, reordering
+ * and loss bursts from the sequence numbers, and one-way latency from the
+ * send stamp and its own RX_DONE stamp. Every probe_window expected packets
+ * it reports the window as a ProbeReport.
+ *
+ * Latency is reported relative to the fastest packet of the test
+ * (clock_offset_us). When both boards are disciplined to PPS the stamps are
+ * UTC and clock_offset_us is the true minimum latency; otherwise it also holds
+ * the offset between the clocks, and their drift shows up as a slow creep of
+ * that figure over long tests.
+ */
+
+#pragma once
+#include <Arduino.h>
+#include "packet.pb.h"
+
+class ProbeTracker
+{
+public:
+    static constexpr uint8_t PROBE_MAGIC = 0x5A;  ///< First byte of a probe payload
+    static constexpr size_t HEADER_SIZE = 13;     ///< Magic, sequence number and send time
+    static constexpr size_t MAX_WINDOW = 256;     ///< Most packets per report, bounded by the latency buffer
+    static constexpr size_t BURST_BUCKETS = sizeof(ProbeReport::burst_hist) / sizeof(uint32_t); ///< Loss bursts of 1, 2, 3-4, 5-8, 9-16, 17+
+
+    static void writeHeader(uint8_t *payload, uint32_t sequence, uint64_t sentUs);
+    static bool readHeader(const uint8_t *payload, size_t length, uint32_t &sequence, uint64_t &sentUs);
+
+    void configure(uint32_t window);
+    void reset();
+    bool enabled() const { return mWindow > 0; }
+    bool add(const Log &log);
+    bool hasPending() const;
+    void fillReport(ProbeReport &report);
+
+private:
+    uint32_t mWindow = 0;        ///< Expected packets per report, 0 disables the test
+    bool mStarted = false;       ///< A probe has been received since the last reset
+    uint32_t mNextSeq = 0;       ///< Sequence number expected next
+    uint64_t mSeen = 0;          ///< Bit i set if mNextSeq - 1 - i was received
+    uint64_t mNewestSentUs = 0;  ///< Send stamp of the probe numbered mNextSeq - 1
+    int64_t mOffsetUs = 0;       ///< Smallest receive minus send time of the test
+    uint32_t mReports = 0;       ///< Reports sent since the last reset
+    uint32_t mTotalReceived = 0; ///< Probes received since the last reset
+    uint32_t mTotalLost = 0;     ///< Probes missing since the last reset
+
+    uint32_t mWindowStart = 0;               ///< First sequence number of the current window
+    uint32_t mReceived = 0;                  ///< Probes received in the window
+    uint32_t mLost = 0;                      ///< Probes missing in the window
+    uint32_t mDuplicates = 0;                ///< Probes received more than once in the window
+    uint32_t mReordered = 0;                 ///< Probes that arrived after a later one in the window
+    uint32_t mCrcErrors = 0;                 ///< Packets with a bad CRC in the window
+    uint32_t mBursts = 0;                    ///< Runs of consecutive missing probes in the window
+    uint32_t mBurstMax = 0;                  ///< Longest run of missing probes in the window
+    uint32_t mBurstHist[BURST_BUCKETS] = {}; ///< Runs of missing probes per length bucket
+    int64_t mLatencyUs[MAX_WINDOW];          ///< Receive minus send time of the probes in the window
+    size_t mLatencyCount = 0;                ///< Number of entries in mLatencyUs
+
+    void startWindow();
+    void noteBurst(uint32_t length);
+    uint32_t latencyPercentile(uint32_t percent) const;
+};
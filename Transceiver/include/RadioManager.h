@@ -1,42 +1,102 @@
 /**
  * @file RadioManager.h
  * @brief Header file for managing the SX1262 radio module and handling transmission and reception of data.
+ *
+ * Reception is handled by a radio task: the DIO1 interrupt only notifies it,
+ * and the task reads the IRQ status, the packet and the RSSI over SPI into a
+ * capture slot and restarts RX straight away. A separate log task then adds
+ * the GPS position and turns the capture into a serial packet, so the radio is
+ * not deaf while that happens. Build with -DRADIO_RX_IN_LOOP to restore the
+ * old path, where the ISR reads the IRQ status and the main loop does the
+ * rest, e.g. for turnaround comparisons.
+ *
+ * With a modulation ladder in the settings, the transmitter polls the receiver
+ * for feedback every adapt_interval_ms between transmissions and both step
+ * along the ladder together (see LinkAdapter). The receiver answers polls from
+ * the radio task; the main loop runs the transmitter's side.
  */
 
 #pragma once
 #include <RadioLib.h>
-#include <TinyGPS++.h>
-#include <vector>
+#include <freertos/FreeRTOS.h>
+#include <freertos/queue.h>
+#include <freertos/semphr.h>
+#include <freertos/task.h>
+#include <esp_timer.h>
 #include "SettingsManager.h"
 #include "packet.pb.h"
+#include "SerialTxManager.h"
+#include "SX1262Burst.h"
+#include "LatencyStats.h"
+#include "ProbeTracker.h"
+#include "LinkAdapter.h"
+#include "GpsManager.h"
+#include "ClockService.h"
 #include "LoraBoards.h"
 
 class RadioManager
 {
 public:
-    RadioManager(SX1262 &radio, HardwareSerial &gpsSerial);
+    static constexpr size_t MAX_BATCH_LOGS = 8; ///< Most reception logs coalesced into one LogBatch
+    static constexpr size_t TX_QUEUE_DEPTH = 8; ///< Payloads that can wait for the radio
+    static constexpr uint8_t AGGREGATE_MAGIC = 0xA5; ///< First byte of a LoRa payload packing several frames
+    static constexpr UBaseType_t TASK_PRIORITY = 5;   ///< Above the serial tasks, so RX restarts promptly
+    static constexpr BaseType_t TASK_CORE = 0;        ///< Core the radio task is pinned to, away from the main loop
+    static constexpr uint32_t TASK_STACK_SIZE = 4096; ///< The capture is written in place, so the radio task needs little
+    static constexpr size_t CAPTURE_SLOTS = 2;        ///< Received packets that can wait for the log task
+    static constexpr UBaseType_t LOG_TASK_PRIORITY = 2; ///< Below the radio task, above the serial tasks and the loop
+    static constexpr BaseType_t LOG_TASK_CORE = 1;      ///< Core the log task is pinned to, so it runs alongside the radio task
+    static constexpr uint32_t LOG_TASK_STACK_SIZE = 12288; ///< Room for a Log, its per-frame copy and an encoded Packet
+    static constexpr uint32_t BATCH_POLL_MS = 10;     ///< How often the log task checks the batch deadline while logs wait
+    static constexpr size_t MAX_RSSI_SAMPLES = sizeof(Log_rssi_log_t::bytes); ///< Samples that fit in Log.rssi_log at one byte each
+    static constexpr uint32_t MIN_RSSI_PERIOD_US = 100; ///< Shortest RSSI sample period; each sample is an SPI read
+    static constexpr uint32_t FEEDBACK_GUARD_MS = 50;   ///< Listening time after a poll on top of two feedback airtimes
+    static constexpr size_t ADAPT_EVENTS = 4;           ///< Adaptation decisions that can wait for the main loop
+    /// Upper bound on an encoded LogBatch packet: type, batch header, GPS and MAX_BATCH_LOGS full logs.
+    static constexpr size_t MAX_BATCH_PACKET_SIZE = 2 + 4 + (2 + Gps_size) + 6 + MAX_BATCH_LOGS * (3 + Log_size);
+
+    RadioManager(SX1262Burst &radio, GpsManager &gps, ClockService &clock, SerialTxManager &serialTx);
     bool initialize(SettingsManager &settings);
     bool configure(const SettingsManager &settings);
     void transmit(const uint8_t *data, size_t length);
+    bool queueTransmission(const uint8_t *data, size_t length, uint32_t &evicted);
+    bool serviceTxQueue();
+    bool startTransmission(const uint8_t *data, size_t length, uint32_t &startUs);
+    bool preloadTransmission(const uint8_t *data, size_t length);
+    void discardPreloaded();
+    size_t txQueueFree() const { return TX_QUEUE_DEPTH - mTxCount; }
+    void fillStats(Stats &stats) const;
     void TxSerialGPSPacket();
     void startReceive();
-    void processReceptionLog();
+    void pollReception();
+    void pollLinkAdaptation();
     void processTransmitLog(int);
-    void handleTransmitted() { transmittedFlag = true; }
-    void handleReceived() { receivedFlag = true; }
+    void flushLogBatch();
+    void handleTransmitted()
+    {
+        int64_t now = esp_timer_get_time();
+        portENTER_CRITICAL_ISR(&mIrqMux);
+        mTxDoneTimeUs = now;
+        portEXIT_CRITICAL_ISR(&mIrqMux);
+        mTxDoneUs = static_cast<uint32_t>(now);
+        transmittedFlag = true;
+    }
+    void handleReceived()
+    {
+        int64_t now = esp_timer_get_time();
+        portENTER_CRITICAL_ISR(&mIrqMux);
+        mIrqTimeUs = now;
+        portEXIT_CRITICAL_ISR(&mIrqMux);
+        receivedFlag = true;
+    }
     void setIrqType() { irqType = mRadio.getIrqFlags(); }
     bool isTransmitted() const { return transmittedFlag; }
     bool isReceived() const { return receivedFlag; }
     State getState() { return state; }
     void setState(State newState);
-    void standby() { mRadio.standby(); }
+    void standby();
 
 private:
-    static constexpr const char *START_DELIMITER = "<START>";
-    static constexpr const char *END_DELIMITER = "<END>";
-    static constexpr size_t START_LEN = 7; ///< Length of the start delimiter
-    static constexpr size_t END_LEN = 5;   ///< Length of the end delimiter
-
     static RadioManager *instance; ///< Singleton instance of RadioManager
     static void transmittedISR()
     {
@@ -48,20 +108,138 @@ private:
         if (instance)
         {
             instance->handleReceived();
+#ifdef RADIO_RX_IN_LOOP
             instance->setIrqType();
+#else
+            BaseType_t woken = pdFALSE;
+            vTaskNotifyGiveFromISR(instance->mTaskHandle, &woken);
+            if (woken)
+                portYIELD_FROM_ISR();
+#endif
         }
     }
+    static void radioTask(void *param);
+    static void logTask(void *param);
+    static void rssiTimerCallback(void *arg);
 
-    SX1262 &mRadio;                ///< Reference to the SX1262 radio module
-    HardwareSerial &gpsSerial;     ///< Reference to the GPS serial interface
-    TinyGPSPlus gps;               ///< TinyGPSPlus instance for GPS data
+    SX1262Burst &mRadio;           ///< Reference to the SX1262 radio module
+    GpsManager &mGps;              ///< Reference to the GPS fix cache
+    ClockService &mClock;          ///< Reference to the UTC clock for log stamps
+    SerialTxManager &mSerialTx;    ///< Reference to the outbound serial queue
     State state = State_STANDBY;   ///< Current state of the radio manager
     volatile bool transmittedFlag; ///< Flag indicating if data has been transmitted
     volatile bool receivedFlag;    ///< Flag indicating if data has been received
     volatile uint32_t irqType = RADIOLIB_SX126X_IRQ_NONE;
     volatile bool instRssiFlag = false;
-    std::vector<int32_t> rssiLog;
+    esp_timer_handle_t mRssiTimer = nullptr;    ///< Periodic timer pacing the RSSI samples
+    uint32_t mRssiPeriodUs = 0;                 ///< RSSI sample period, one LoRa symbol unless set
+    uint8_t mRssiSamples[MAX_RSSI_SAMPLES];     ///< RSSI samples of the packet being received, in -0.5 dBm steps
+    size_t mRssiCount = 0;                      ///< Number of samples in mRssiSamples
+    volatile uint32_t mRssiDue = 0;             ///< Timer ticks since boot
+    uint32_t mRssiHandled = 0;                  ///< Timer ticks already sampled or counted as missed
+    uint32_t mRssiMissed = 0;                   ///< Ticks of this packet with no sample because the task was late
+    RssiEncoding mRssiEncoding = RssiEncoding_RSSI_INT32; ///< How the samples are packed into Log.rssi_log
+    uint32_t mRssiHistogram[256];               ///< Samples of the packet per raw RSSI value, for RSSI_SUMMARY
+    TaskHandle_t mTaskHandle = nullptr; ///< Radio task handling reception
+    SemaphoreHandle_t mLock = nullptr;  ///< Serialises SPI and RSSI sampling between the radio task and the main loop
+    portMUX_TYPE mIrqMux = portMUX_INITIALIZER_UNLOCKED; ///< Guards the 64-bit interrupt timestamps
+    volatile int64_t mIrqTimeUs = 0;    ///< esp_timer_get_time() of the last DIO1 interrupt in RX
+    int64_t mHeaderTimeUs = 0;          ///< esp_timer_get_time() of the valid header of the packet being received
+    LatencyStats mRxTurnaround;         ///< RX_DONE interrupt to reception restarted, i.e. the RX dead time
+
+    Log mCapture[CAPTURE_SLOTS];           ///< Received packets waiting for the log task
+    QueueHandle_t mCaptureFree = nullptr;  ///< Indices of the capture slots the radio task may fill
+    QueueHandle_t mCaptureReady = nullptr; ///< Indices of the filled capture slots, in reception order
+    TaskHandle_t mLogTaskHandle = nullptr; ///< Log task turning captures into serial packets
+    SemaphoreHandle_t mLogLock = nullptr;  ///< Serialises batch and capture access between the log task and the main loop
+    uint32_t mRxCaptureDropped = 0;        ///< Packets received while every capture slot was still waiting
+    ProbeTracker mProbe;                   ///< Loss and latency of received probes, when the probe test is on
 
-    void TxSerialLogPacket(const Log &log);
-    void ProcessGPSData(Gps &gps);
+    Settings mApplied = Settings_init_zero; ///< Radio parameters as last applied to the module
+    bool mRadioConfigured = false;          ///< mApplied is complete; until then every command is sent
+    LatencyStats mReconfigureTime;          ///< Time spent sending radio commands per settings update
+    uint32_t mImageCalibrations = 0;        ///< Image calibrations run because the band changed
+    uint32_t mRssiPeriodConfigUs = 0;       ///< RSSI sample period from the settings, 0 for one symbol
+
+    /// Where the transmitter is in a poll exchange.
+    enum LinkPhase
+    {
+        LINK_IDLE,      ///< Sending host payloads
+        LINK_POLLING,   ///< The poll is on air
+        LINK_LISTENING, ///< Waiting for the feedback
+    };
+    LinkAdapter mAdapter;                ///< Rung choice and feedback bookkeeping, when adaptation is on
+    LinkPhase mLinkPhase = LINK_IDLE;    ///< Progress of the current poll exchange
+    uint32_t mPollMs = 0;                ///< millis() when the latest poll was sent
+    uint32_t mListenMs = 0;              ///< millis() when listening for feedback started
+    uint32_t mListenWindowMs = 0;        ///< How long to listen for the feedback
+    LinkAdapt mAdaptEvents[ADAPT_EVENTS]; ///< Decisions waiting to be sent to the host, guarded by mLock
+    size_t mAdaptEventCount = 0;         ///< Number of entries in mAdaptEvents
+
+    Transmission_payload_t mTxQueue[TX_QUEUE_DEPTH];       ///< Payloads waiting for the radio, oldest at mTxHead
+    size_t mTxHead = 0;                                    ///< Index of the oldest queued payload
+    size_t mTxCount = 0;                                   ///< Number of queued payloads
+    TxOverflow mTxOverflow = TxOverflow_TX_OVERFLOW_BLOCK; ///< What to do with a payload when the queue is full
+    uint32_t mTxRejected = 0;                              ///< Payloads refused under TX_OVERFLOW_BLOCK
+    uint32_t mTxDroppedNewest = 0;                         ///< Payloads discarded under TX_OVERFLOW_DROP_NEWEST
+    uint32_t mTxDroppedOldest = 0;                         ///< Queued payloads evicted under TX_OVERFLOW_DROP_OLDEST
+    uint32_t mTxQueueUs[TX_QUEUE_DEPTH];                   ///< micros() when each queued payload arrived
+    bool mTxBurst = false;                                 ///< Stage the next payload while the current one is on air
+    volatile uint32_t mTxDoneUs = 0;                       ///< micros() of the last TX_DONE interrupt
+    volatile int64_t mTxDoneTimeUs = 0;                    ///< esp_timer_get_time() of the last TX_DONE interrupt
+    uint32_t mTxStarted = 0;                               ///< Transmissions started
+    LatencyStats mTxGap;                                   ///< TX_DONE to next start, for payloads that were waiting
+    uint32_t mTxFrames[TX_QUEUE_DEPTH];                    ///< Host frames carried by each queued payload
+    uint32_t mPreloadFrames = 0;                           ///< Host frames carried by the staged payload
+    Transmission_payload_t mPreloadCopy = {0, {0}};        ///< Copy of a staged payload taken off the TX queue
+    bool mPreloadFromQueue = false;                        ///< The staged payload was taken off the TX queue
+    bool mRequeued = false;                                ///< mPreloadCopy was unstaged and goes out ahead of the queue
+    uint32_t mOnAirFrames = 0;                             ///< Host frames carried by the payload last started
+    Packet mTxLogPacket;                                   ///< Transmit log being sent, built under mLock, kept off the caller's stack
+
+    Transmission_payload_t mAggregate = {0, {0}}; ///< Frames being packed into one LoRa payload
+    uint32_t mAggregateFrames = 0;                ///< Number of frames in mAggregate
+    uint32_t mAggregateStartMs = 0;               ///< millis() when the first frame was packed
+    uint32_t mAggregateBytes = 0;                 ///< Packed payload size from the settings, 0 disables aggregation
+    uint32_t mAggregateTimeoutMs = 0;             ///< Longest a frame may wait to be packed
+
+    Log mBatch[MAX_BATCH_LOGS];    ///< Reception logs waiting to be sent as one LogBatch
+    size_t mBatchCount = 0;        ///< Number of logs in mBatch
+    Gps mBatchGps = Gps_init_zero; ///< Position of the first log in mBatch, sent with the batch
+    Gps mBatchLastGps = Gps_init_zero; ///< Position of the latest log in mBatch, the base of the next delta
+    uint32_t mBatchStartMs = 0;    ///< millis() when the first log of the batch was queued
+    uint32_t mBatchSize = 0;       ///< Logs per batch from the settings, 0 or 1 disables batching
+    uint32_t mBatchTimeoutMs = 0;  ///< Longest a log may wait in the batch, 0 for no deadline
+    Packet mLogPacket;             ///< Reception log or batch being sent, guarded by mLogLock
+
+    bool applySettings(const SettingsManager &settings);
+    bool applyRadioSettings(const Settings &config, bool &changed);
+    void processReceptionLog();
+    void processCapture(uint8_t slot);
+    void drainCaptures();
+    void sendProbeReport();
+    bool linkPollDue() const;
+    void pollFeedback();
+    void abortPoll();
+    bool answerPoll(const Log &log);
+    bool applyRung(LinkAdapt &decision);
+    void queueAdaptEvent(const LinkAdapt &decision);
+    void updateRssiPeriod();
+    void unstagePreloaded();
+    void startRssiSampling();
+    void stopRssiSampling();
+    void sampleRssi();
+    void encodeRssiLog(Log &log) const;
+    void summarizeRssi(RssiSummary &summary) const;
+    void TxSerialLogPacket(Packet &packet);
+    void queueReceptionLog(const Log &log);
+    bool enqueuePayload(const uint8_t *data, size_t length, uint32_t frames, uint32_t &evicted);
+    bool packFrame(const uint8_t *data, size_t length, uint32_t &evicted);
+    void flushAggregate(bool force = false);
+    bool queueAggregateLogs(const Log &log);
+    void popTxQueue();
+    void noteTxStart(bool waiting);
+    static bool encodeBatchLogs(pb_ostream_t *stream, const pb_field_t *field, void *const *arg);
+    int64_t readStamp(const volatile int64_t &stamp);
+    void stampUtc(Log &log);
 };
\ No newline at end of file
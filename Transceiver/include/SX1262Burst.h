@@ -0,0 +1,47 @@
+/**
+ * @file SX1262Burst.h
+ * @brief Header file for an SX1262 driver that stages the next payload while the current one is on air.
+ *
+ * The SX126x data buffer is split into two 128-byte halves. While a packet is
+ * transmitted from one half, the next payload is written into the other, so
+ * once TX_DONE arrives only the buffer base address, packet length and SetTx
+ * have to be sent. Payloads longer than HALF_SIZE use the normal path.
+ *
+ * It also remembers which image calibration band the chip was last calibrated
+ * for, so retuning within a band skips the calibration RadioLib would redo on
+ * every step of 20 MHz or more.
+ */
+
+#pragma once
+#include <RadioLib.h>
+
+class SX1262Burst : public SX1262
+{
+public:
+    static constexpr size_t HALF_SIZE = 128; ///< Size of each half of the radio's data buffer
+
+    SX1262Burst(Module *mod) : SX1262(mod) {}
+
+    using SX1262::startTransmit;
+    int16_t startTransmit(const uint8_t *data, size_t len, uint8_t addr = 0) override;
+
+    void setPacketConfig(uint16_t preambleLength, bool crc);
+    int16_t tune(float freq, bool &calibrated);
+    bool canPreload(size_t len) const { return !mPreloaded && len <= HALF_SIZE && mOnAirLength <= HALF_SIZE; }
+    int16_t preload(const uint8_t *data, size_t len);
+    bool hasPreloaded() const { return mPreloaded; }
+    int16_t startPreloaded();
+    void discardPreloaded() { mPreloaded = false; }
+    size_t onAirLength() const { return mOnAirLength; }
+
+private:
+    uint16_t mPreambleLength = 8;                    ///< LoRa preamble length, mirrored from the settings
+    uint8_t mCrcType = RADIOLIB_SX126X_LORA_CRC_ON;  ///< LoRa CRC setting, mirrored from the settings
+    uint8_t mOnAirHalf = 0;                          ///< Buffer half of the packet last started
+    size_t mOnAirLength = 0;                         ///< Length of the packet last started
+    uint8_t mPreloadLength = 0;                      ///< Length of the staged payload
+    bool mPreloaded = false;                         ///< A payload is staged in the other half
+    uint16_t mImageBand = 0;                         ///< Calibration band the chip holds, 0 if unknown
+
+    static void imageBand(float freq, uint8_t band[2]);
+};
@@ -1,6 +1,10 @@
 /**
  * @file SerialTaskManager.h
  * @brief Header file for managing serial communication tasks using FreeRTOS.
+ *
+ * Reception is driven by the UART driver's RX events (FIFO threshold or idle
+ * timeout). Build with -DSERIAL_RX_POLLING to restore the old 1 ms polling
+ * loop, e.g. for latency comparisons.
  */
 
 #pragma once
@@ -10,11 +14,18 @@
 #include <freertos/task.h>
 #include "pb.h"
 #include "packet.pb.h"
+#include "FrameCodec.h"
 
+/**
+ * @brief A decoded host message waiting in the frame pool.
+ * @details The slot is owned by the receiver of the queue item until it is
+ *          handed back with SerialTaskManager::release().
+ */
 struct ProtoData
 {
-    uint8_t *buffer;
+    uint8_t slot;
     size_t length;
+    uint32_t rxTimeUs; ///< micros() when the frame was completed
 };
 
 class SerialTaskManager
@@ -25,21 +36,37 @@ public:
 
     bool begin();
     QueueHandle_t getQueue() const { return mTaskQueue; }
+    const uint8_t *frame(uint8_t slot) const { return &mSlab[slot * mBufferSize]; }
+    void release(uint8_t slot);
+    void fillStats(Stats &stats) const;
+    uint32_t errorCount() const { return mDecoder.crcErrorCount() + mDecoder.malformedCount() + mDecoder.overflowCount(); }
 
 private:
-    static constexpr const char *START_DELIMITER = "<START>";
-    static constexpr const char *END_DELIMITER = "<END>";
-    static constexpr size_t START_LEN = 7; ///< Length of the start delimiter
-    static constexpr size_t END_LEN = 5;   ///< Length of the end delimiter
+    static constexpr uint8_t NO_SLOT = 0xFF;
+    static constexpr size_t RX_CHUNK = 128;          ///< Bytes moved from the UART driver per read
+    static constexpr uint8_t RX_FIFO_THRESHOLD = 64; ///< RX FIFO fill level that raises an event
+    static constexpr uint32_t RX_IDLE_WAKE_MS = 100; ///< Safety-net wakeup if an event is missed
 
     QueueHandle_t mTaskQueue;     ///< Handle for the FreeRTOS task queue
+    QueueHandle_t mFreeQueue;     ///< Indices of the pool slots not currently in use
     TaskHandle_t mTaskHandle;     ///< Handle for the FreeRTOS task
-    uint8_t *mSerialBuffer;       ///< Buffer for storing serial data
-    size_t mBufferSize;           ///< Size of the serial buffer
-    size_t mBufferIndex;          ///< Current index in the serial buffer
+    size_t mBufferSize;           ///< Size of each frame slot
     const UBaseType_t mQueueSize; ///< Size of the task queue
+    const uint8_t mPoolSlots;     ///< Number of frame slots in the pool
+    uint8_t *mSlab;               ///< Frame slots plus one scratch slot, allocated once
+    uint8_t *mTaskQueueStorage;   ///< Storage for the static task queue
+    uint8_t *mFreeQueueStorage;   ///< Storage for the static free-slot queue
+    StaticQueue_t mTaskQueueBuffer;
+    StaticQueue_t mFreeQueueBuffer;
+    FrameDecoder mDecoder;        ///< Incremental decoder for framed host messages
+    uint8_t mRxSlot = NO_SLOT;    ///< Slot the decoder is currently writing into
+
+    uint32_t mPoolExhausted = 0; ///< Frames dropped because no slot was free
+    uint32_t mQueueFull = 0;     ///< Frames dropped because the task queue was full
+    UBaseType_t mMinFree;        ///< Lowest number of free slots observed
 
     static void serialTask(void *param);
     void processSerialData();
-    void handleCompleteMessage(uint8_t *start, uint8_t *end);
-};
\ No newline at end of file
+    void handleCompleteMessage(size_t length, uint32_t rxTimeUs);
+    void acquireRxSlot();
+};
@@ -0,0 +1,71 @@
+/**
+ * @file SerialTxManager.h
+ * @brief Header file for the asynchronous serial transmit task and its outbound ring buffer.
+ */
+
+#pragma once
+#include <Arduino.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/ringbuf.h>
+#include <freertos/semphr.h>
+#include <freertos/task.h>
+#include "pb.h"
+#include "pb_encode.h"
+#include "packet.pb.h"
+#include "FrameCodec.h"
+
+class SerialTxManager
+{
+public:
+    /// What to do with a packet that does not fit in the ring buffer.
+    enum OverflowPolicy
+    {
+        DROP_NEWEST,     ///< Discard the packet being sent
+        OVERWRITE_OLDEST ///< Discard queued packets, oldest first, until it fits or a baud rate change is pending
+    };
+
+    SerialTxManager(size_t ringSize = 8192, size_t maxPacketSize = 2048, OverflowPolicy policy = DROP_NEWEST);
+
+    /// Smallest no-split ring that holds an item of maxPacketSize: items are 4-byte aligned
+    /// with an 8-byte header, and no item may exceed half the ring.
+    static constexpr size_t ringSizeFor(size_t maxPacketSize)
+    {
+        return 2 * (((maxPacketSize + HEADER_LEN + 3) & ~static_cast<size_t>(3)) + 8);
+    }
+    ~SerialTxManager();
+
+    bool begin();
+    bool sendPacket(const Packet &packet);
+    Packet &reply();
+    bool changeBaudRate(uint32_t baudRate);
+    void fillStats(Stats &stats) const;
+
+    static constexpr size_t HEADER_LEN = 1;                  ///< Per-item header holding the item's framing
+
+private:
+    static constexpr uint8_t CONTROL_BAUD_RATE = 0xFF;       ///< Header of an item switching the baud rate
+    static constexpr uint32_t CONTROL_SEND_TIMEOUT_MS = 100; ///< Longest wait to queue a control item
+
+    RingbufHandle_t mRing;          ///< Outbound ring buffer of encoded packets
+    StaticRingbuffer_t mRingStruct; ///< Control block for the static ring buffer
+    TaskHandle_t mTaskHandle;       ///< Handle for the FreeRTOS task
+    SemaphoreHandle_t mControlLock; ///< Keeps a baud rate change from being queued while a producer evicts
+    const size_t mRingSize;         ///< Size of the ring buffer storage
+    const size_t mMaxPacketSize;    ///< Largest encoded packet accepted
+    const OverflowPolicy mPolicy;   ///< Policy applied when the ring buffer is full
+    uint8_t *mRingStorage;          ///< Storage for the ring buffer, allocated once
+    uint8_t *mFrameBuffer;          ///< Framed bytes of the packet being written out
+    const size_t mFrameBufferSize;  ///< Size of the frame buffer
+
+    uint32_t mFrames = 0;         ///< Packets written to the serial port
+    uint32_t mDropped = 0;        ///< Packets discarded because they did not fit or were too large to queue
+    uint32_t mOverwritten = 0;    ///< Queued packets discarded under OVERWRITE_OLDEST
+    size_t mHighWater = 0;        ///< Most bytes ever in use in the ring buffer
+    uint32_t mControlPending = 0; ///< Control items queued and not yet applied, guarded by mControlLock
+    Packet mReply;                ///< Packet the main loop builds its replies in, see reply()
+
+    static void txTask(void *param);
+    void writeItem(uint8_t *item, size_t size);
+    void applyControl(const uint8_t *item);
+    bool acquire(void **item, size_t size);
+};
@@ -10,13 +10,14 @@
 #include "pb_encode.h"
 #include "pb_decode.h"
 #include "packet.pb.h"
+#include "SerialTxManager.h"
 
 class SettingsManager
 {
 public:
     Settings mConfig;
 
-    explicit SettingsManager(SX1262 &radio);
+    SettingsManager(SX1262 &radio, SerialTxManager &serialTx);
 
     // Core functionality
     bool initialize();
@@ -26,12 +27,8 @@ public:
     void sendProto();
 
 private:
-    static constexpr const char *START_DELIMITER = "<START>";
-    static constexpr const char *END_DELIMITER = "<END>";
-    static constexpr size_t START_LEN = 7; ///< Length of the start delimiter
-    static constexpr size_t END_LEN = 5;   ///< Length of the end delimiter
-
     SX1262 &mRadio;                          ///< Reference to the SX1262 radio module
+    SerialTxManager &mSerialTx;              ///< Reference to the outbound serial queue
     const char *mFilename = "/settings.bin"; ///< Filename for storing settings
 
     void initFilesystem();
@@ -0,0 +1,79 @@
+/**
+ * @file TxScheduler.h
+ * @brief Header file for the on-device periodic transmitter.
+ *
+ * A hardware timer ticks once per period; the ISR counts and stamps the tick
+ * and wakes the scheduler task, which starts the transmission. The task runs
+ * above the radio and serial tasks and apart from the main loop, so the start
+ * does not wait behind host packets, flash writes or serial prints; it only
+ * waits for RadioManager's lock, which the loop holds briefly. The next payload
+ * is generated and staged in the radio while the current one is on air, so on
+ * the tick only SetTx is left to do. A tick that arrives while the previous
+ * packet is still on air is counted as missed rather than delayed.
+ *
+ * PATTERN_PROBE payloads carry a sequence number and the time they were sent
+ * (see ProbeTracker). They are not staged, so the send time can be written
+ * right before the transmission starts.
+ */
+
+#pragma once
+#include <Arduino.h>
+#include "packet.pb.h"
+#include "RadioManager.h"
+#include "LatencyStats.h"
+#include "ProbeTracker.h"
+#include "ClockService.h"
+
+class TxScheduler
+{
+public:
+    static constexpr uint8_t TIMER_NUMBER = 0;        ///< Hardware timer used for the schedule
+    static constexpr uint16_t TIMER_DIVIDER = 80;     ///< 80 MHz APB clock / 80 = 1 tick per microsecond
+    static constexpr uint32_t MIN_PERIOD_US = 1000;   ///< Shortest period accepted from the host
+    static constexpr UBaseType_t TASK_PRIORITY = 6;   ///< Above the radio task, so a slot is never held up by it
+    static constexpr BaseType_t TASK_CORE = 0;        ///< Core the scheduler task is pinned to, away from the main loop
+    static constexpr uint32_t TASK_STACK_SIZE = 6144; ///< Room to encode the transmit log into the serial ring
+
+    TxScheduler(RadioManager &radioMgr, ClockService &clock);
+
+    bool begin();
+    bool start(const Schedule &schedule);
+    void stop();
+    bool isRunning() const { return mRunning; }
+    bool takeFinished();
+    void fillStats(Stats &stats) const;
+
+private:
+    static TxScheduler *instance; ///< Singleton instance, for the timer ISR
+    static void IRAM_ATTR onTimer();
+    static void schedulerTask(void *param);
+
+    RadioManager &mRadioMgr;                          ///< Reference to the RadioManager
+    ClockService &mClock;                             ///< Reference to the clock that stamps probes
+    hw_timer_t *mTimer = nullptr;                     ///< Hardware timer, allocated on first start
+    portMUX_TYPE mMux = portMUX_INITIALIZER_UNLOCKED; ///< Guards the tick count and stamp
+    TaskHandle_t mTaskHandle = nullptr;               ///< Scheduler task woken by the timer
+    SemaphoreHandle_t mLock = nullptr;                ///< Serialises the schedule between the scheduler task and the main loop
+
+    volatile uint32_t mTicks = 0;  ///< Timer ticks since the schedule started
+    volatile uint32_t mTickUs = 0; ///< micros() of the latest tick
+    uint32_t mHandledTicks = 0;    ///< Ticks already acted upon
+
+    Schedule mSchedule = Schedule_init_zero;                 ///< Schedule requested by the host
+    volatile bool mRunning = false;                          ///< The timer is running
+    bool mFinished = false;                                  ///< The schedule reached its count and has not been reported
+    uint8_t mPayload[sizeof(Transmission_payload_t::bytes)]; ///< Payload for the next slot
+    size_t mLength = 0;                                      ///< Length of mPayload
+    bool mStaged = false;                                    ///< mPayload holds the payload for the next slot
+
+    uint32_t mSent = 0;         ///< Slots a transmission was started in
+    uint32_t mMissed = 0;       ///< Slots skipped because the radio or the task was still busy
+    uint32_t mFirstStartUs = 0; ///< micros() of the first transmission started
+    uint32_t mLastStartUs = 0;  ///< micros() of the latest transmission started
+    LatencyStats mDelay;        ///< Timer tick to transmission start
+    LatencyStats mInterval;     ///< Between consecutive transmission starts
+
+    void poll();
+    void halt();
+    void stage();
+};
@@ -0,0 +1,101 @@
+/**
+ * @file UbxParser.h
+ * @brief Header file for a compact parser of u-blox UBX frames.
+ *
+ * A UBX frame is 0xB5 0x62, class, id, a little-endian payload length, the
+ * payload and a two-byte Fletcher checksum over everything after the sync
+ * bytes. The parser takes one byte at a time and keeps only the frame being
+ * received, so the GPS task can feed it straight from the UART. Frames with a
+ * payload longer than MAX_PAYLOAD are skipped. Only NAV-PVT is decoded; ACK
+ * frames are left to the caller.
+ */
+
+#pragma once
+#include <Arduino.h>
+
+class UbxParser
+{
+public:
+    static constexpr uint8_t SYNC_1 = 0xB5;     ///< First sync byte
+    static constexpr uint8_t SYNC_2 = 0x62;     ///< Second sync byte
+    static constexpr uint8_t CLASS_NAV = 0x01;  ///< Navigation results
+    static constexpr uint8_t CLASS_ACK = 0x05;  ///< Acknowledgements of CFG frames
+    static constexpr uint8_t CLASS_CFG = 0x06;  ///< Configuration
+    static constexpr uint8_t NAV_PVT = 0x07;    ///< Position, velocity and time solution
+    static constexpr uint8_t ACK_NAK = 0x00;    ///< CFG frame rejected
+    static constexpr uint8_t ACK_ACK = 0x01;    ///< CFG frame accepted
+    static constexpr uint8_t CFG_PRT = 0x00;    ///< Port configuration
+    static constexpr uint8_t CFG_MSG = 0x01;    ///< Message output rates
+    static constexpr uint8_t CFG_RATE = 0x08;   ///< Navigation rate
+    static constexpr size_t NAV_PVT_MIN_SIZE = 84; ///< NAV-PVT payload of protocol 14; later versions append fields
+    static constexpr size_t MAX_PAYLOAD = 100;  ///< Largest payload kept, room for NAV-PVT
+    static constexpr size_t FRAME_OVERHEAD = 8; ///< Sync, class, id, length and checksum bytes
+
+    /// The NAV-PVT fields the firmware uses.
+    struct NavPvt
+    {
+        uint32_t iTowMs = 0;     ///< GPS time of week of the navigation epoch
+        uint16_t year = 0;       ///< UTC year
+        uint8_t month = 0;       ///< UTC month, 1-12
+        uint8_t day = 0;         ///< UTC day, 1-31
+        uint8_t hour = 0;        ///< UTC hour
+        uint8_t minute = 0;      ///< UTC minute
+        uint8_t second = 0;      ///< UTC second
+        uint8_t valid = 0;       ///< Validity flags of the UTC date and time
+        int32_t nanoNs = 0;      ///< Fraction of the UTC second, may be negative
+        uint8_t fixType = 0;     ///< 0 none, 2 2D, 3 3D, 4 GNSS + dead reckoning, 5 time only
+        uint8_t flags = 0;       ///< Fix status flags, bit 0 gnssFixOK
+        uint8_t numSv = 0;       ///< Satellites used in the solution
+        int32_t lonE7 = 0;       ///< Longitude in 1e-7 degrees
+        int32_t latE7 = 0;       ///< Latitude in 1e-7 degrees
+        uint32_t hAccMm = 0;     ///< Horizontal accuracy estimate
+        int32_t gSpeedMmS = 0;   ///< Ground speed
+        int32_t headMotE5 = 0;   ///< Heading of motion in 1e-5 degrees
+
+        bool hasFix() const { return (flags & 0x01) && fixType >= 2 && fixType <= 4; }
+        bool hasTime() const { return (valid & 0x07) == 0x07; } ///< Date and time valid, time of day fully resolved
+    };
+
+    bool feed(uint8_t c);
+    uint8_t msgClass() const { return mClass; }
+    uint8_t msgId() const { return mId; }
+    const uint8_t *payload() const { return mPayload; }
+    uint16_t length() const { return mLength; }
+    bool readNavPvt(NavPvt &pvt) const;
+    uint32_t frameCount() const { return mFrames; }
+    uint32_t checksumErrors() const { return mChecksumErrors; }
+
+    static size_t writeFrame(uint8_t msgClass, uint8_t msgId, const uint8_t *payload, uint16_t length, uint8_t *frame);
+
+private:
+    /// Position within the frame being received.
+    enum Step : uint8_t
+    {
+        WAIT_SYNC_1,
+        WAIT_SYNC_2,
+        READ_CLASS,
+        READ_ID,
+        READ_LENGTH_LOW,
+        READ_LENGTH_HIGH,
+        READ_PAYLOAD,
+        READ_CHECKSUM_A,
+        READ_CHECKSUM_B,
+    };
+
+    Step mStep = WAIT_SYNC_1;         ///< Next byte expected
+    uint8_t mClass = 0;               ///< Class of the frame being received
+    uint8_t mId = 0;                  ///< Id of the frame being received
+    uint16_t mLength = 0;             ///< Payload length of the frame being received
+    uint16_t mReceived = 0;           ///< Payload bytes received so far
+    uint8_t mCheckA = 0;              ///< Running checksum, first byte
+    uint8_t mCheckB = 0;              ///< Running checksum, second byte
+    uint8_t mPayload[MAX_PAYLOAD];    ///< Payload of the frame being received
+    uint32_t mFrames = 0;             ///< Frames that passed the checksum
+    uint32_t mChecksumErrors = 0;     ///< Frames that failed it
+
+    void check(uint8_t c)
+    {
+        mCheckA += c;
+        mCheckB += mCheckA;
+    }
+};
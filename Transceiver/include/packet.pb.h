@@ -17,7 +17,12 @@ typedef enum _PacketType {
     PacketType_LOG = 3,
     PacketType_REQUEST = 4,
     PacketType_GPS = 5,
-    PacketType_ACK = 6
+    PacketType_ACK = 6,
+    PacketType_STATS = 7,
+    PacketType_LOG_BATCH = 8,
+    PacketType_LINK_TEST = 9,
+    PacketType_PROBE_REPORT = 10,
+    PacketType_LINK_ADAPT = 11
 } PacketType;
 
 typedef enum _State {
@@ -26,7 +31,56 @@ typedef enum _State {
     State_RECEIVER = 2
 } State;
 
+typedef enum _Framing {
+    Framing_FRAMING_UNCHANGED = 0,
+    Framing_FRAMING_DELIMITED = 1,
+    Framing_FRAMING_COBS = 2
+} Framing;
+
+typedef enum _TxOverflow {
+    TxOverflow_TX_OVERFLOW_BLOCK = 0,
+    TxOverflow_TX_OVERFLOW_DROP_NEWEST = 1,
+    TxOverflow_TX_OVERFLOW_DROP_OLDEST = 2
+} TxOverflow;
+
+typedef enum _PayloadPattern {
+    PayloadPattern_PATTERN_SEQUENCE = 0,
+    PayloadPattern_PATTERN_RANDOM = 1,
+    PayloadPattern_PATTERN_ZEROS = 2,
+    PayloadPattern_PATTERN_PROBE = 3
+} PayloadPattern;
+
+typedef enum _RssiEncoding {
+    RssiEncoding_RSSI_INT32 = 0,
+    RssiEncoding_RSSI_HALF_DB = 1,
+    RssiEncoding_RSSI_DELTA = 2,
+    RssiEncoding_RSSI_SUMMARY = 3
+} RssiEncoding;
+
+typedef enum _AdaptReason {
+    AdaptReason_ADAPT_START = 0,
+    AdaptReason_ADAPT_PER_HIGH = 1,
+    AdaptReason_ADAPT_MARGIN_LOW = 2,
+    AdaptReason_ADAPT_MARGIN_HIGH = 3,
+    AdaptReason_ADAPT_NO_FEEDBACK = 4,
+    AdaptReason_ADAPT_LINK_LOST = 5,
+    AdaptReason_ADAPT_PEER = 6
+} AdaptReason;
+
+typedef enum _ClockSource {
+    ClockSource_CLOCK_LOCAL = 0,
+    ClockSource_CLOCK_GNSS = 1,
+    ClockSource_CLOCK_PPS = 2
+} ClockSource;
+
 /* Struct definitions */
+typedef struct _LinkRung {
+    int32_t spreading_factor;
+    float bandwidth;
+    int32_t coding_rate;
+    int32_t power;
+} LinkRung;
+
 typedef struct _Settings {
     float frequency;
     int32_t power;
@@ -36,20 +90,54 @@ typedef struct _Settings {
     int32_t preamble;
     bool set_crc;
     uint32_t sync_word;
+    uint32_t batch_size;
+    uint32_t batch_timeout_ms;
+    TxOverflow tx_overflow;
+    bool tx_burst;
+    uint32_t aggregate_bytes;
+    uint32_t aggregate_timeout_ms;
+    uint32_t rssi_period_us;
+    RssiEncoding rssi_encoding;
+    uint32_t probe_window;
+    pb_size_t ladder_count;
+    LinkRung ladder[6];
+    uint32_t adapt_interval_ms;
+    uint32_t adapt_target_per_ppm;
+    float adapt_margin_db;
+    float adapt_hysteresis_db;
 } Settings;
 
 typedef PB_BYTES_ARRAY_T(255) Transmission_payload_t;
 typedef struct _Transmission {
     Transmission_payload_t payload;
+    uint32_t sequence;
 } Transmission;
 
 typedef struct _Gps {
     double latitude;
     double longitude;
     uint32_t satellites;
+    uint32_t fix_age_ms;
+    int32_t latitude_e7;
+    int32_t longitude_e7;
+    uint32_t hdop_centi;
+    uint32_t speed_cm_s;
+    uint32_t course_cdeg;
+    bool delta;
 } Gps;
 
-typedef PB_BYTES_ARRAY_T(400) Log_rssi_log_t;
+typedef struct _RssiSummary {
+    uint32_t count;
+    float min;
+    float max;
+    float mean;
+    float variance;
+    float p10;
+    float p50;
+    float p90;
+} RssiSummary;
+
+typedef PB_BYTES_ARRAY_T(1024) Log_rssi_log_t;
 typedef PB_BYTES_ARRAY_T(255) Log_payload_t;
 typedef struct _Log {
     bool crc_error;
@@ -60,15 +148,162 @@ typedef struct _Log {
     float rssi_avg;
     float snr;
     Log_payload_t payload;
+    uint32_t batch_offset_ms;
+    uint32_t tx_queued;
+    uint32_t tx_rejected;
+    uint32_t tx_dropped_newest;
+    uint32_t tx_dropped_oldest;
+    uint32_t frame_index;
+    uint32_t frame_count;
+    uint32_t rssi_period_us;
+    uint32_t rssi_missed;
+    RssiEncoding rssi_encoding;
+    bool has_rssi_summary;
+    RssiSummary rssi_summary;
+    uint64_t header_valid_us;
+    uint64_t rx_done_us;
+    uint64_t tx_start_us;
+    uint64_t prev_tx_done_us;
+    uint32_t time_on_air_us;
+    ClockSource clock_source;
+    uint32_t clock_error_us;
 } Log;
 
+typedef struct _LogBatch {
+    bool has_gps;
+    Gps gps;
+    uint32_t start_ms;
+    pb_callback_t logs;
+} LogBatch;
+
+typedef struct _Schedule {
+    uint32_t period_us;
+    uint32_t payload_length;
+    PayloadPattern pattern;
+    uint32_t count;
+} Schedule;
+
 typedef struct _Request {
     bool search;
     bool settings;
     bool gps;
     State stateChange;
+    Framing framing;
+    bool stats;
+    uint32_t baud_rate;
+    bool baud_commit;
+    bool has_schedule;
+    Schedule schedule;
+    uint32_t credit_poll;
 } Request;
 
+typedef PB_BYTES_ARRAY_T(255) LinkTest_payload_t;
+typedef struct _LinkTest {
+    uint32_t sequence;
+    LinkTest_payload_t payload;
+    uint32_t rx_frames;
+    uint32_t rx_errors;
+    uint32_t rx_bytes_per_s;
+} LinkTest;
+
+typedef struct _Credit {
+    uint32_t sequence;
+    uint32_t credits;
+    uint32_t capacity;
+    uint32_t evicted;
+} Credit;
+
+typedef struct _Latency {
+    uint32_t samples;
+    uint32_t min_us;
+    uint32_t mean_us;
+    uint32_t max_us;
+    uint32_t stddev_us;
+} Latency;
+
+typedef struct _Stats {
+    uint32_t rx_frames;
+    uint32_t rx_crc_errors;
+    uint32_t rx_overflows;
+    uint32_t rx_malformed;
+    uint32_t pool_slots;
+    uint32_t pool_free;
+    uint32_t pool_min_free;
+    uint32_t pool_exhausted;
+    uint32_t queue_full;
+    bool has_command_latency;
+    Latency command_latency;
+    uint32_t tx_frames;
+    uint32_t tx_dropped;
+    uint32_t tx_overwritten;
+    uint32_t tx_ring_size;
+    uint32_t tx_high_water;
+    bool has_tx_gap;
+    Latency tx_gap;
+    uint32_t tx_started;
+    uint32_t sched_sent;
+    uint32_t sched_missed;
+    uint32_t sched_rate_mhz;
+    bool has_sched_delay;
+    Latency sched_delay;
+    bool has_sched_interval;
+    Latency sched_interval;
+    bool has_rx_turnaround;
+    Latency rx_turnaround;
+    uint32_t rx_capture_dropped;
+    bool has_reconfigure_time;
+    Latency reconfigure_time;
+    uint32_t image_calibrations;
+    uint32_t gps_sentences;
+    uint32_t gps_checksum_errors;
+    float gps_fix_rate_hz;
+    bool has_gps_parse_time;
+    Latency gps_parse_time;
+    uint32_t gps_interval_ms;
+    bool gps_ubx;
+    ClockSource clock_source;
+    uint32_t clock_error_us;
+    uint32_t pps_edges;
+    uint32_t clock_steps;
+    float clock_drift_ppm;
+} Stats;
+
+typedef struct _ProbeReport {
+    uint32_t window;
+    uint32_t expected;
+    uint32_t received;
+    uint32_t lost;
+    uint32_t duplicates;
+    uint32_t reordered;
+    uint32_t crc_errors;
+    uint32_t per_ppm;
+    int64_t clock_offset_us;
+    uint32_t latency_p50_us;
+    uint32_t latency_p90_us;
+    uint32_t latency_p99_us;
+    uint32_t latency_max_us;
+    uint32_t bursts;
+    uint32_t burst_max;
+    pb_size_t burst_hist_count;
+    uint32_t burst_hist[6];
+    uint32_t total_received;
+    uint32_t total_lost;
+} ProbeReport;
+
+typedef struct _LinkAdapt {
+    uint32_t rung;
+    uint32_t previous_rung;
+    AdaptReason reason;
+    bool applied;
+    uint32_t sent;
+    uint32_t received;
+    uint32_t per_ppm;
+    float snr;
+    float margin_db;
+    bool has_settings;
+    LinkRung settings;
+} LinkAdapt;
+
 typedef struct _Packet {
     PacketType type;
     bool has_settings;
@@ -82,6 +317,18 @@ typedef struct _Packet {
     bool has_gps;
     Gps gps;
     bool ack;
+    bool has_stats;
+    Stats stats;
+    bool has_log_batch;
+    LogBatch log_batch;
+    bool has_link_test;
+    LinkTest link_test;
+    bool has_credit;
+    Credit credit;
+    bool has_probe_report;
+    ProbeReport probe_report;
+    bool has_link_adapt;
+    LinkAdapt link_adapt;
 } Packet;
 
 
@@ -91,37 +338,103 @@ extern "C" {
 
 /* Helper constants for enums */
 #define _PacketType_MIN PacketType_UNSPECIFIED
-#define _PacketType_MAX PacketType_ACK
-#define _PacketType_ARRAYSIZE ((PacketType)(PacketType_ACK+1))
+#define _PacketType_MAX PacketType_LINK_ADAPT
+#define _PacketType_ARRAYSIZE ((PacketType)(PacketType_LINK_ADAPT+1))
 
 #define _State_MIN State_STANDBY
 #define _State_MAX State_RECEIVER
 #define _State_ARRAYSIZE ((State)(State_RECEIVER+1))
 
+#define _Framing_MIN Framing_FRAMING_UNCHANGED
+#define _Framing_MAX Framing_FRAMING_COBS
+#define _Framing_ARRAYSIZE ((Framing)(Framing_FRAMING_COBS+1))
+
+#define _TxOverflow_MIN TxOverflow_TX_OVERFLOW_BLOCK
+#define _TxOverflow_MAX TxOverflow_TX_OVERFLOW_DROP_OLDEST
+#define _TxOverflow_ARRAYSIZE ((TxOverflow)(TxOverflow_TX_OVERFLOW_DROP_OLDEST+1))
+
+#define _PayloadPattern_MIN PayloadPattern_PATTERN_SEQUENCE
+#define _PayloadPattern_MAX PayloadPattern_PATTERN_PROBE
+#define _PayloadPattern_ARRAYSIZE ((PayloadPattern)(PayloadPattern_PATTERN_PROBE+1))
+
+#define _RssiEncoding_MIN RssiEncoding_RSSI_INT32
+#define _RssiEncoding_MAX RssiEncoding_RSSI_SUMMARY
+#define _RssiEncoding_ARRAYSIZE ((RssiEncoding)(RssiEncoding_RSSI_SUMMARY+1))
 
+#define _AdaptReason_MIN AdaptReason_ADAPT_START
+#define _AdaptReason_MAX AdaptReason_ADAPT_PEER
+#define _AdaptReason_ARRAYSIZE ((AdaptReason)(AdaptReason_ADAPT_PEER+1))
 
+#define _ClockSource_MIN ClockSource_CLOCK_LOCAL
+#define _ClockSource_MAX ClockSource_CLOCK_PPS
+#define _ClockSource_ARRAYSIZE ((ClockSource)(ClockSource_CLOCK_PPS+1))
 
 
+#define Settings_tx_overflow_ENUMTYPE TxOverflow
+#define Settings_rssi_encoding_ENUMTYPE RssiEncoding
+
+
+
+
+#define Log_rssi_encoding_ENUMTYPE RssiEncoding
+#define Log_clock_source_ENUMTYPE ClockSource
+
+
+#define Schedule_pattern_ENUMTYPE PayloadPattern
+
 #define Request_stateChange_ENUMTYPE State
+#define Request_framing_ENUMTYPE Framing
+
+
+
+
+
+#define Stats_clock_source_ENUMTYPE ClockSource
+
+#define LinkAdapt_reason_ENUMTYPE AdaptReason
 
 #define Packet_type_ENUMTYPE PacketType
 
 
 /* Initializer values for message structs */
-#define Settings_init_default                    {0, 0, 0, 0, 0, 0, 0, 0}
-#define Transmission_init_default                {{0, {0}}}
-#define Gps_init_default                         {0, 0, 0}
-#define Log_init_default                         {0, 0, false, Gps_init_default, {0, {0}}, 0, 0, {0, {0}}}
-#define Request_init_default                     {0, 0, 0, _State_MIN}
-#define Packet_init_default                      {_PacketType_MIN, false, Settings_init_default, false, Transmission_init_default, false, Log_init_default, false, Request_init_default, false, Gps_init_default, 0}
-#define Settings_init_zero                       {0, 0, 0, 0, 0, 0, 0, 0}
-#define Transmission_init_zero                   {{0, {0}}}
-#define Gps_init_zero                            {0, 0, 0}
-#define Log_init_zero                            {0, 0, false, Gps_init_zero, {0, {0}}, 0, 0, {0, {0}}}
-#define Request_init_zero                        {0, 0, 0, _State_MIN}
-#define Packet_init_zero                         {_PacketType_MIN, false, Settings_init_zero, false, Transmission_init_zero, false, Log_init_zero, false, Request_init_zero, false, Gps_init_zero, 0}
+#define LinkRung_init_default                    {0, 0, 0, 0}
+#define Settings_init_default                    {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, _TxOverflow_MIN, 0, 0, 0, 0, _RssiEncoding_MIN, 0, 0, {LinkRung_init_default, LinkRung_init_default, LinkRung_init_default, LinkRung_init_default, LinkRung_init_default, LinkRung_init_default}, 0, 0, 0, 0}
+#define Transmission_init_default                {{0, {0}}, 0}
+#define Gps_init_default                         {0, 0, 0, 0, 0, 0, 0, 0, 0, 0}
+#define RssiSummary_init_default                 {0, 0, 0, 0, 0, 0, 0, 0}
+#define Log_init_default                         {0, 0, false, Gps_init_default, {0, {0}}, 0, 0, {0, {0}}, 0, 0, 0, 0, 0, 0, 0, 0, 0, _RssiEncoding_MIN, false, RssiSummary_init_default, 0, 0, 0, 0, 0, _ClockSource_MIN, 0}
+#define LogBatch_init_default                    {false, Gps_init_default, 0, {{NULL}, NULL}}
+#define Schedule_init_default                    {0, 0, _PayloadPattern_MIN, 0}
+#define Request_init_default                     {0, 0, 0, _State_MIN, _Framing_MIN, 0, 0, 0, false, Schedule_init_default, 0}
+#define LinkTest_init_default                    {0, {0, {0}}, 0, 0, 0}
+#define Credit_init_default                      {0, 0, 0, 0}
+#define Latency_init_default                     {0, 0, 0, 0, 0}
+#define Stats_init_default                       {0, 0, 0, 0, 0, 0, 0, 0, 0, false, Latency_init_default, 0, 0, 0, 0, 0, false, Latency_init_default, 0, 0, 0, 0, false, Latency_init_default, false, Latency_init_default, false, Latency_init_default, 0, false, Latency_init_default, 0, 0, 0, 0, false, Latency_init_default, 0, 0, _ClockSource_MIN, 0, 0, 0, 0}
+#define ProbeReport_init_default                 {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, {0, 0, 0, 0, 0, 0}, 0, 0}
+#define LinkAdapt_init_default                   {0, 0, _AdaptReason_MIN, 0, 0, 0, 0, 0, 0, false, LinkRung_init_default}
+#define Packet_init_default                      {_PacketType_MIN, false, Settings_init_default, false, Transmission_init_default, false, Log_init_default, false, Request_init_default, false, Gps_init_default, 0, false, Stats_init_default, false, LogBatch_init_default, false, LinkTest_init_default, false, Credit_init_default, false, ProbeReport_init_default, false, LinkAdapt_init_default}
+#define LinkRung_init_zero                       {0, 0, 0, 0}
+#define Settings_init_zero                       {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, _TxOverflow_MIN, 0, 0, 0, 0, _RssiEncoding_MIN, 0, 0, {LinkRung_init_zero, LinkRung_init_zero, LinkRung_init_zero, LinkRung_init_zero, LinkRung_init_zero, LinkRung_init_zero}, 0, 0, 0, 0}
+#define Transmission_init_zero                   {{0, {0}}, 0}
+#define Gps_init_zero                            {0, 0, 0, 0, 0, 0, 0, 0, 0, 0}
+#define RssiSummary_init_zero                    {0, 0, 0, 0, 0, 0, 0, 0}
+#define Log_init_zero                            {0, 0, false, Gps_init_zero, {0, {0}}, 0, 0, {0, {0}}, 0, 0, 0, 0, 0, 0, 0, 0, 0, _RssiEncoding_MIN, false, RssiSummary_init_zero, 0, 0, 0, 0, 0, _ClockSource_MIN, 0}
+#define LogBatch_init_zero                       {false, Gps_init_zero, 0, {{NULL}, NULL}}
+#define Schedule_init_zero                       {0, 0, _PayloadPattern_MIN, 0}
+#define Request_init_zero                        {0, 0, 0, _State_MIN, _Framing_MIN, 0, 0, 0, false, Schedule_init_zero, 0}
+#define LinkTest_init_zero                       {0, {0, {0}}, 0, 0, 0}
+#define Credit_init_zero                         {0, 0, 0, 0}
+#define Latency_init_zero                        {0, 0, 0, 0, 0}
+#define Stats_init_zero                          {0, 0, 0, 0, 0, 0, 0, 0, 0, false, Latency_init_zero, 0, 0, 0, 0, 0, false, Latency_init_zero, 0, 0, 0, 0, false, Latency_init_zero, false, Latency_init_zero, false, Latency_init_zero, 0, false, Latency_init_zero, 0, 0, 0, 0, false, Latency_init_zero, 0, 0, _ClockSource_MIN, 0, 0, 0, 0}
+#define ProbeReport_init_zero                    {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, {0, 0, 0, 0, 0, 0}, 0, 0}
+#define LinkAdapt_init_zero                      {0, 0, _AdaptReason_MIN, 0, 0, 0, 0, 0, 0, false, LinkRung_init_zero}
+#define Packet_init_zero                         {_PacketType_MIN, false, Settings_init_zero, false, Transmission_init_zero, false, Log_init_zero, false, Request_init_zero, false, Gps_init_zero, 0, false, Stats_init_zero, false, LogBatch_init_zero, false, LinkTest_init_zero, false, Credit_init_zero, false, ProbeReport_init_zero, false, LinkAdapt_init_zero}
 
 /* Field tags (for use in manual encoding/decoding) */
+#define LinkRung_spreading_factor_tag            1
+#define LinkRung_bandwidth_tag                   2
+#define LinkRung_coding_rate_tag                 3
+#define LinkRung_power_tag                       4
 #define Settings_frequency_tag                   1
 #define Settings_power_tag                       2
 #define Settings_bandwidth_tag                   3
@@ -130,10 +443,40 @@ extern "C" {
 #define Settings_preamble_tag                    6
 #define Settings_set_crc_tag                     7
 #define Settings_sync_word_tag                   8
+#define Settings_batch_size_tag                  9
+#define Settings_batch_timeout_ms_tag            10
+#define Settings_tx_overflow_tag                 11
+#define Settings_tx_burst_tag                    12
+#define Settings_aggregate_bytes_tag             13
+#define Settings_aggregate_timeout_ms_tag        14
+#define Settings_rssi_period_us_tag              15
+#define Settings_rssi_encoding_tag               16
+#define Settings_probe_window_tag                17
+#define Settings_ladder_tag                      18
+#define Settings_adapt_interval_ms_tag           19
+#define Settings_adapt_target_per_ppm_tag        20
+#define Settings_adapt_margin_db_tag             21
+#define Settings_adapt_hysteresis_db_tag         22
 #define Transmission_payload_tag                 1
+#define Transmission_sequence_tag                2
 #define Gps_latitude_tag                         1
 #define Gps_longitude_tag                        2
 #define Gps_satellites_tag                       3
+#define Gps_fix_age_ms_tag                       4
+#define Gps_latitude_e7_tag                      5
+#define Gps_longitude_e7_tag                     6
+#define Gps_hdop_centi_tag                       7
+#define Gps_speed_cm_s_tag                       8
+#define Gps_course_cdeg_tag                      9
+#define Gps_delta_tag                            10
+#define RssiSummary_count_tag                    1
+#define RssiSummary_min_tag                      2
+#define RssiSummary_max_tag                      3
+#define RssiSummary_mean_tag                     4
+#define RssiSummary_variance_tag                 5
+#define RssiSummary_p10_tag                      6
+#define RssiSummary_p50_tag                      7
+#define RssiSummary_p90_tag                      8
 #define Log_crc_error_tag                        1
 #define Log_general_error_tag                    2
 #define Log_gps_tag                              3
@@ -141,10 +484,120 @@ extern "C" {
 #define Log_rssi_avg_tag                         5
 #define Log_snr_tag                              6
 #define Log_payload_tag                          7
+#define Log_batch_offset_ms_tag                  8
+#define Log_tx_queued_tag                        9
+#define Log_tx_rejected_tag                      10
+#define Log_tx_dropped_newest_tag                11
+#define Log_tx_dropped_oldest_tag                12
+#define Log_frame_index_tag                      13
+#define Log_frame_count_tag                      14
+#define Log_rssi_period_us_tag                   15
+#define Log_rssi_missed_tag                      16
+#define Log_rssi_encoding_tag                    17
+#define Log_rssi_summary_tag                     18
+#define Log_header_valid_us_tag                  19
+#define Log_rx_done_us_tag                       20
+#define Log_tx_start_us_tag                      21
+#define Log_prev_tx_done_us_tag                  22
+#define Log_time_on_air_us_tag                   23
+#define Log_clock_source_tag                     24
+#define Log_clock_error_us_tag                   25
+#define LogBatch_gps_tag                         1
+#define LogBatch_start_ms_tag                    2
+#define LogBatch_logs_tag                        3
+#define Schedule_period_us_tag                   1
+#define Schedule_payload_length_tag              2
+#define Schedule_pattern_tag                     3
+#define Schedule_count_tag                       4
 #define Request_search_tag                       1
 #define Request_settings_tag                     2
 #define Request_gps_tag                          3
 #define Request_stateChange_tag                  4
+#define Request_framing_tag                      5
+#define Request_stats_tag                        6
+#define Request_baud_rate_tag                    7
+#define Request_baud_commit_tag                  8
+#define Request_schedule_tag                     9
+#define Request_credit_poll_tag                  10
+#define LinkTest_sequence_tag                    1
+#define LinkTest_payload_tag                     2
+#define LinkTest_rx_frames_tag                   3
+#define LinkTest_rx_errors_tag                   4
+#define LinkTest_rx_bytes_per_s_tag              5
+#define Credit_sequence_tag                      1
+#define Credit_credits_tag                       2
+#define Credit_capacity_tag                      3
+#define Credit_evicted_tag                       4
+#define Latency_samples_tag                      1
+#define Latency_min_us_tag                       2
+#define Latency_mean_us_tag                      3
+#define Latency_max_us_tag                       4
+#define Latency_stddev_us_tag                    5
+#define Stats_rx_frames_tag                      1
+#define Stats_rx_crc_errors_tag                  2
+#define Stats_rx_overflows_tag                   3
+#define Stats_rx_malformed_tag                   4
+#define Stats_pool_slots_tag                     5
+#define Stats_pool_free_tag                      6
+#define Stats_pool_min_free_tag                  7
+#define Stats_pool_exhausted_tag                 8
+#define Stats_queue_full_tag                     9
+#define Stats_command_latency_tag                10
+#define Stats_tx_frames_tag                      11
+#define Stats_tx_dropped_tag                     12
+#define Stats_tx_overwritten_tag                 13
+#define Stats_tx_ring_size_tag                   14
+#define Stats_tx_high_water_tag                  15
+#define Stats_tx_gap_tag                         16
+#define Stats_tx_started_tag                     17
+#define Stats_sched_sent_tag                     18
+#define Stats_sched_missed_tag                   19
+#define Stats_sched_rate_mhz_tag                 20
+#define Stats_sched_delay_tag                    21
+#define Stats_sched_interval_tag                 22
+#define Stats_rx_turnaround_tag                  23
+#define Stats_rx_capture_dropped_tag             24
+#define Stats_reconfigure_time_tag               25
+#define Stats_image_calibrations_tag             26
+#define Stats_gps_sentences_tag                  27
+#define Stats_gps_checksum_errors_tag            28
+#define Stats_gps_fix_rate_hz_tag                29
+#define Stats_gps_parse_time_tag                 30
+#define Stats_gps_interval_ms_tag                31
+#define Stats_gps_ubx_tag                        32
+#define Stats_clock_source_tag                   33
+#define Stats_clock_error_us_tag                 34
+#define Stats_pps_edges_tag                      35
+#define Stats_clock_steps_tag                    36
+#define Stats_clock_drift_ppm_tag                37
+#define ProbeReport_window_tag                   1
+#define ProbeReport_expected_tag                 2
+#define ProbeReport_received_tag                 3
+#define ProbeReport_lost_tag                     4
+#define ProbeReport_duplicates_tag               5
+#define ProbeReport_reordered_tag                6
+#define ProbeReport_crc_errors_tag               7
+#define ProbeReport_per_ppm_tag                  8
+#define ProbeReport_clock_offset_us_tag          9
+#define ProbeReport_latency_p50_us_tag           10
+#define ProbeReport_latency_p90_us_tag           11
+#define ProbeReport_latency_p99_us_tag           12
+#define ProbeReport_latency_max_us_tag           13
+#define ProbeReport_bursts_tag                   14
+#define ProbeReport_burst_max_tag                15
+#define ProbeReport_burst_hist_tag               16
+#define ProbeReport_total_received_tag           17
+#define ProbeReport_total_lost_tag               18
+#define LinkAdapt_rung_tag                       1
+#define LinkAdapt_previous_rung_tag              2
+#define LinkAdapt_reason_tag                     3
+#define LinkAdapt_applied_tag                    4
+#define LinkAdapt_sent_tag                       5
+#define LinkAdapt_received_tag                   6
+#define LinkAdapt_per_ppm_tag                    7
+#define LinkAdapt_snr_tag                        8
+#define LinkAdapt_margin_db_tag                  9
+#define LinkAdapt_settings_tag                   10
 #define Packet_type_tag                          1
 #define Packet_settings_tag                      2
 #define Packet_transmission_tag                  3
@@ -152,8 +605,22 @@ extern "C" {
 #define Packet_request_tag                       5
 #define Packet_gps_tag                           6
 #define Packet_ack_tag                           7
+#define Packet_stats_tag                         8
+#define Packet_log_batch_tag                     9
+#define Packet_link_test_tag                     10
+#define Packet_credit_tag                        11
+#define Packet_probe_report_tag                  12
+#define Packet_link_adapt_tag                    13
 
 /* Struct field encoding specification for nanopb */
+#define LinkRung_FIELDLIST(X, a) \
+X(a, STATIC,   SINGULAR, INT32,    spreading_factor,   1) \
+X(a, STATIC,   SINGULAR, FLOAT,    bandwidth,         2) \
+X(a, STATIC,   SINGULAR, INT32,    coding_rate,       3) \
+X(a, STATIC,   SINGULAR, INT32,    power,             4)
+#define LinkRung_CALLBACK NULL
+#define LinkRung_DEFAULT NULL
+
 #define Settings_FIELDLIST(X, a) \
 X(a, STATIC,   SINGULAR, FLOAT,    frequency,         1) \
 X(a, STATIC,   SINGULAR, INT32,    power,             2) \
@@ -162,22 +629,57 @@ X(a, STATIC,   SINGULAR, INT32,    spreading_factor,   4) \
 X(a, STATIC,   SINGULAR, INT32,    coding_rate,       5) \
 X(a, STATIC,   SINGULAR, INT32,    preamble,          6) \
 X(a, STATIC,   SINGULAR, BOOL,     set_crc,           7) \
-X(a, STATIC,   SINGULAR, UINT32,   sync_word,         8)
+X(a, STATIC,   SINGULAR, UINT32,   sync_word,         8) \
+X(a, STATIC,   SINGULAR, UINT32,   batch_size,        9) \
+X(a, STATIC,   SINGULAR, UINT32,   batch_timeout_ms,  10) \
+X(a, STATIC,   SINGULAR, UENUM,    tx_overflow,      11) \
+X(a, STATIC,   SINGULAR, BOOL,     tx_burst,         12) \
+X(a, STATIC,   SINGULAR, UINT32,   aggregate_bytes,  13) \
+X(a, STATIC,   SINGULAR, UINT32,   aggregate_timeout_ms,  14) \
+X(a, STATIC,   SINGULAR, UINT32,   rssi_period_us,   15) \
+X(a, STATIC,   SINGULAR, UENUM,    rssi_encoding,    16) \
+X(a, STATIC,   SINGULAR, UINT32,   probe_window,     17) \
+X(a, STATIC,   REPEATED, MESSAGE,  ladder,           18) \
+X(a, STATIC,   SINGULAR, UINT32,   adapt_interval_ms,  19) \
+X(a, STATIC,   SINGULAR, UINT32,   adapt_target_per_ppm,  20) \
+X(a, STATIC,   SINGULAR, FLOAT,    adapt_margin_db,  21) \
+X(a, STATIC,   SINGULAR, FLOAT,    adapt_hysteresis_db,  22)
 #define Settings_CALLBACK NULL
 #define Settings_DEFAULT NULL
+#define Settings_ladder_MSGTYPE LinkRung
 
 #define Transmission_FIELDLIST(X, a) \
-X(a, STATIC,   SINGULAR, BYTES,    payload,           1)
+X(a, STATIC,   SINGULAR, BYTES,    payload,           1) \
+X(a, STATIC,   SINGULAR, UINT32,   sequence,          2)
 #define Transmission_CALLBACK NULL
 #define Transmission_DEFAULT NULL
 
 #define Gps_FIELDLIST(X, a) \
 X(a, STATIC,   SINGULAR, DOUBLE,   latitude,          1) \
 X(a, STATIC,   SINGULAR, DOUBLE,   longitude,         2) \
-X(a, STATIC,   SINGULAR, UINT32,   satellites,        3)
+X(a, STATIC,   SINGULAR, UINT32,   satellites,        3) \
+X(a, STATIC,   SINGULAR, UINT32,   fix_age_ms,        4) \
+X(a, STATIC,   SINGULAR, SINT32,   latitude_e7,       5) \
+X(a, STATIC,   SINGULAR, SINT32,   longitude_e7,      6) \
+X(a, STATIC,   SINGULAR, UINT32,   hdop_centi,        7) \
+X(a, STATIC,   SINGULAR, UINT32,   speed_cm_s,        8) \
+X(a, STATIC,   SINGULAR, UINT32,   course_cdeg,       9) \
+X(a, STATIC,   SINGULAR, BOOL,     delta,            10)
 #define Gps_CALLBACK NULL
 #define Gps_DEFAULT NULL
 
+#define RssiSummary_FIELDLIST(X, a) \
+X(a, STATIC,   SINGULAR, UINT32,   count,             1) \
+X(a, STATIC,   SINGULAR, FLOAT,    min,               2) \
+X(a, STATIC,   SINGULAR, FLOAT,    max,               3) \
+X(a, STATIC,   SINGULAR, FLOAT,    mean,              4) \
+X(a, STATIC,   SINGULAR, FLOAT,    variance,          5) \
+X(a, STATIC,   SINGULAR, FLOAT,    p10,               6) \
+X(a, STATIC,   SINGULAR, FLOAT,    p50,               7) \
+X(a, STATIC,   SINGULAR, FLOAT,    p90,               8)
+#define RssiSummary_CALLBACK NULL
+#define RssiSummary_DEFAULT NULL
+
 #define Log_FIELDLIST(X, a) \
 X(a, STATIC,   SINGULAR, BOOL,     crc_error,         1) \
 X(a, STATIC,   SINGULAR, BOOL,     general_error,     2) \
@@ -185,18 +687,172 @@ X(a, STATIC,   OPTIONAL, MESSAGE,  gps,               3) \
 X(a, STATIC,   SINGULAR, BYTES,    rssi_log,          4) \
 X(a, STATIC,   SINGULAR, FLOAT,    rssi_avg,          5) \
 X(a, STATIC,   SINGULAR, FLOAT,    snr,               6) \
-X(a, STATIC,   SINGULAR, BYTES,    payload,           7)
+X(a, STATIC,   SINGULAR, BYTES,    payload,           7) \
+X(a, STATIC,   SINGULAR, UINT32,   batch_offset_ms,   8) \
+X(a, STATIC,   SINGULAR, UINT32,   tx_queued,         9) \
+X(a, STATIC,   SINGULAR, UINT32,   tx_rejected,      10) \
+X(a, STATIC,   SINGULAR, UINT32,   tx_dropped_newest,  11) \
+X(a, STATIC,   SINGULAR, UINT32,   tx_dropped_oldest,  12) \
+X(a, STATIC,   SINGULAR, UINT32,   frame_index,      13) \
+X(a, STATIC,   SINGULAR, UINT32,   frame_count,      14) \
+X(a, STATIC,   SINGULAR, UINT32,   rssi_period_us,   15) \
+X(a, STATIC,   SINGULAR, UINT32,   rssi_missed,      16) \
+X(a, STATIC,   SINGULAR, UENUM,    rssi_encoding,    17) \
+X(a, STATIC,   OPTIONAL, MESSAGE,  rssi_summary,     18) \
+X(a, STATIC,   SINGULAR, UINT64,   header_valid_us,  19) \
+X(a, STATIC,   SINGULAR, UINT64,   rx_done_us,       20) \
+X(a, STATIC,   SINGULAR, UINT64,   tx_start_us,      21) \
+X(a, STATIC,   SINGULAR, UINT64,   prev_tx_done_us,  22) \
+X(a, STATIC,   SINGULAR, UINT32,   time_on_air_us,   23) \
+X(a, STATIC,   SINGULAR, UENUM,    clock_source,     24) \
+X(a, STATIC,   SINGULAR, UINT32,   clock_error_us,   25)
 #define Log_CALLBACK NULL
 #define Log_DEFAULT NULL
 #define Log_gps_MSGTYPE Gps
+#define Log_rssi_summary_MSGTYPE RssiSummary
+
+#define LogBatch_FIELDLIST(X, a) \
+X(a, STATIC,   OPTIONAL, MESSAGE,  gps,               1) \
+X(a, STATIC,   SINGULAR, UINT32,   start_ms,          2) \
+X(a, CALLBACK, REPEATED, MESSAGE,  logs,              3)
+#define LogBatch_CALLBACK pb_default_field_callback
+#define LogBatch_DEFAULT NULL
+#define LogBatch_gps_MSGTYPE Gps
+#define LogBatch_logs_MSGTYPE Log
+
+#define Schedule_FIELDLIST(X, a) \
+X(a, STATIC,   SINGULAR, UINT32,   period_us,         1) \
+X(a, STATIC,   SINGULAR, UINT32,   payload_length,    2) \
+X(a, STATIC,   SINGULAR, UENUM,    pattern,           3) \
+X(a, STATIC,   SINGULAR, UINT32,   count,             4)
+#define Schedule_CALLBACK NULL
+#define Schedule_DEFAULT NULL
 
 #define Request_FIELDLIST(X, a) \
 X(a, STATIC,   SINGULAR, BOOL,     search,            1) \
 X(a, STATIC,   SINGULAR, BOOL,     settings,          2) \
 X(a, STATIC,   SINGULAR, BOOL,     gps,               3) \
-X(a, STATIC,   SINGULAR, UENUM,    stateChange,       4)
+X(a, STATIC,   SINGULAR, UENUM,    stateChange,       4) \
+X(a, STATIC,   SINGULAR, UENUM,    framing,           5) \
+X(a, STATIC,   SINGULAR, BOOL,     stats,             6) \
+X(a, STATIC,   SINGULAR, UINT32,   baud_rate,         7) \
+X(a, STATIC,   SINGULAR, BOOL,     baud_commit,       8) \
+X(a, STATIC,   OPTIONAL, MESSAGE,  schedule,          9) \
+X(a, STATIC,   SINGULAR, UINT32,   credit_poll,      10)
 #define Request_CALLBACK NULL
 #define Request_DEFAULT NULL
+#define Request_schedule_MSGTYPE Schedule
+
+#define LinkTest_FIELDLIST(X, a) \
+X(a, STATIC,   SINGULAR, UINT32,   sequence,          1) \
+X(a, STATIC,   SINGULAR, BYTES,    payload,           2) \
+X(a, STATIC,   SINGULAR, UINT32,   rx_frames,         3) \
+X(a, STATIC,   SINGULAR, UINT32,   rx_errors,         4) \
+X(a, STATIC,   SINGULAR, UINT32,   rx_bytes_per_s,    5)
+#define LinkTest_CALLBACK NULL
+#define LinkTest_DEFAULT NULL
+
+#define Credit_FIELDLIST(X, a) \
+X(a, STATIC,   SINGULAR, UINT32,   sequence,          1) \
+X(a, STATIC,   SINGULAR, UINT32,   credits,           2) \
+X(a, STATIC,   SINGULAR, UINT32,   capacity,          3) \
+X(a, STATIC,   SINGULAR, UINT32,   evicted,           4)
+#define Credit_CALLBACK NULL
+#define Credit_DEFAULT NULL
+
+#define Latency_FIELDLIST(X, a) \
+X(a, STATIC,   SINGULAR, UINT32,   samples,           1) \
+X(a, STATIC,   SINGULAR, UINT32,   min_us,            2) \
+X(a, STATIC,   SINGULAR, UINT32,   mean_us,           3) \
+X(a, STATIC,   SINGULAR, UINT32,   max_us,            4) \
+X(a, STATIC,   SINGULAR, UINT32,   stddev_us,         5)
+#define Latency_CALLBACK NULL
+#define Latency_DEFAULT NULL
+
+#define Stats_FIELDLIST(X, a) \
+X(a, STATIC,   SINGULAR, UINT32,   rx_frames,         1) \
+X(a, STATIC,   SINGULAR, UINT32,   rx_crc_errors,     2) \
+X(a, STATIC,   SINGULAR, UINT32,   rx_overflows,      3) \
+X(a, STATIC,   SINGULAR, UINT32,   rx_malformed,      4) \
+X(a, STATIC,   SINGULAR, UINT32,   pool_slots,        5) \
+X(a, STATIC,   SINGULAR, UINT32,   pool_free,         6) \
+X(a, STATIC,   SINGULAR, UINT32,   pool_min_free,     7) \
+X(a, STATIC,   SINGULAR, UINT32,   pool_exhausted,    8) \
+X(a, STATIC,   SINGULAR, UINT32,   queue_full,        9) \
+X(a, STATIC,   OPTIONAL, MESSAGE,  command_latency,  10) \
+X(a, STATIC,   SINGULAR, UINT32,   tx_frames,        11) \
+X(a, STATIC,   SINGULAR, UINT32,   tx_dropped,       12) \
+X(a, STATIC,   SINGULAR, UINT32,   tx_overwritten,   13) \
+X(a, STATIC,   SINGULAR, UINT32,   tx_ring_size,     14) \
+X(a, STATIC,   SINGULAR, UINT32,   tx_high_water,    15) \
+X(a, STATIC,   OPTIONAL, MESSAGE,  tx_gap,           16) \
+X(a, STATIC,   SINGULAR, UINT32,   tx_started,       17) \
+X(a, STATIC,   SINGULAR, UINT32,   sched_sent,       18) \
+X(a, STATIC,   SINGULAR, UINT32,   sched_missed,     19) \
+X(a, STATIC,   SINGULAR, UINT32,   sched_rate_mhz,   20) \
+X(a, STATIC,   OPTIONAL, MESSAGE,  sched_delay,      21) \
+X(a, STATIC,   OPTIONAL, MESSAGE,  sched_interval,   22) \
+X(a, STATIC,   OPTIONAL, MESSAGE,  rx_turnaround,    23) \
+X(a, STATIC,   SINGULAR, UINT32,   rx_capture_dropped,  24) \
+X(a, STATIC,   OPTIONAL, MESSAGE,  reconfigure_time,  25) \
+X(a, STATIC,   SINGULAR, UINT32,   image_calibrations,  26) \
+X(a, STATIC,   SINGULAR, UINT32,   gps_sentences,    27) \
+X(a, STATIC,   SINGULAR, UINT32,   gps_checksum_errors,  28) \
+X(a, STATIC,   SINGULAR, FLOAT,    gps_fix_rate_hz,  29) \
+X(a, STATIC,   OPTIONAL, MESSAGE,  gps_parse_time,   30) \
+X(a, STATIC,   SINGULAR, UINT32,   gps_interval_ms,  31) \
+X(a, STATIC,   SINGULAR, BOOL,     gps_ubx,          32) \
+X(a, STATIC,   SINGULAR, UENUM,    clock_source,     33) \
+X(a, STATIC,   SINGULAR, UINT32,   clock_error_us,   34) \
+X(a, STATIC,   SINGULAR, UINT32,   pps_edges,        35) \
+X(a, STATIC,   SINGULAR, UINT32,   clock_steps,      36) \
+X(a, STATIC,   SINGULAR, FLOAT,    clock_drift_ppm,  37)
+#define Stats_CALLBACK NULL
+#define Stats_DEFAULT NULL
+#define Stats_command_latency_MSGTYPE Latency
+#define Stats_tx_gap_MSGTYPE Latency
+#define Stats_sched_delay_MSGTYPE Latency
+#define Stats_sched_interval_MSGTYPE Latency
+#define Stats_rx_turnaround_MSGTYPE Latency
+#define Stats_reconfigure_time_MSGTYPE Latency
+#define Stats_gps_parse_time_MSGTYPE Latency
+
+#define ProbeReport_FIELDLIST(X, a) \
+X(a, STATIC,   SINGULAR, UINT32,   window,            1) \
+X(a, STATIC,   SINGULAR, UINT32,   expected,          2) \
+X(a, STATIC,   SINGULAR, UINT32,   received,          3) \
+X(a, STATIC,   SINGULAR, UINT32,   lost,              4) \
+X(a, STATIC,   SINGULAR, UINT32,   duplicates,        5) \
+X(a, STATIC,   SINGULAR, UINT32,   reordered,         6) \
+X(a, STATIC,   SINGULAR, UINT32,   crc_errors,        7) \
+X(a, STATIC,   SINGULAR, UINT32,   per_ppm,           8) \
+X(a, STATIC,   SINGULAR, SINT64,   clock_offset_us,   9) \
+X(a, STATIC,   SINGULAR, UINT32,   latency_p50_us,   10) \
+X(a, STATIC,   SINGULAR, UINT32,   latency_p90_us,   11) \
+X(a, STATIC,   SINGULAR, UINT32,   latency_p99_us,   12) \
+X(a, STATIC,   SINGULAR, UINT32,   latency_max_us,   13) \
+X(a, STATIC,   SINGULAR, UINT32,   bursts,           14) \
+X(a, STATIC,   SINGULAR, UINT32,   burst_max,        15) \
+X(a, STATIC,   REPEATED, UINT32,   burst_hist,       16) \
+X(a, STATIC,   SINGULAR, UINT32,   total_received,   17) \
+X(a, STATIC,   SINGULAR, UINT32,   total_lost,       18)
+#define ProbeReport_CALLBACK NULL
+#define ProbeReport_DEFAULT NULL
+
+#define LinkAdapt_FIELDLIST(X, a) \
+X(a, STATIC,   SINGULAR, UINT32,   rung,              1) \
+X(a, STATIC,   SINGULAR, UINT32,   previous_rung,     2) \
+X(a, STATIC,   SINGULAR, UENUM,    reason,            3) \
+X(a, STATIC,   SINGULAR, BOOL,     applied,           4) \
+X(a, STATIC,   SINGULAR, UINT32,   sent,              5) \
+X(a, STATIC,   SINGULAR, UINT32,   received,          6) \
+X(a, STATIC,   SINGULAR, UINT32,   per_ppm,           7) \
+X(a, STATIC,   SINGULAR, FLOAT,    snr,               8) \
+X(a, STATIC,   SINGULAR, FLOAT,    margin_db,         9) \
+X(a, STATIC,   OPTIONAL, MESSAGE,  settings,         10)
+#define LinkAdapt_CALLBACK NULL
+#define LinkAdapt_DEFAULT NULL
+#define LinkAdapt_settings_MSGTYPE LinkRung
 
 #define Packet_FIELDLIST(X, a) \
 X(a, STATIC,   SINGULAR, UENUM,    type,              1) \
@@ -205,7 +861,13 @@ X(a, STATIC,   OPTIONAL, MESSAGE,  transmission,      3) \
 X(a, STATIC,   OPTIONAL, MESSAGE,  log,               4) \
 X(a, STATIC,   OPTIONAL, MESSAGE,  request,           5) \
 X(a, STATIC,   OPTIONAL, MESSAGE,  gps,               6) \
-X(a, STATIC,   SINGULAR, BOOL,     ack,               7)
+X(a, STATIC,   SINGULAR, BOOL,     ack,               7) \
+X(a, STATIC,   OPTIONAL, MESSAGE,  stats,             8) \
+X(a, STATIC,   OPTIONAL, MESSAGE,  log_batch,         9) \
+X(a, STATIC,   OPTIONAL, MESSAGE,  link_test,        10) \
+X(a, STATIC,   OPTIONAL, MESSAGE,  credit,           11) \
+X(a, STATIC,   OPTIONAL, MESSAGE,  probe_report,     12) \
+X(a, STATIC,   OPTIONAL, MESSAGE,  link_adapt,       13)
 #define Packet_CALLBACK NULL
 #define Packet_DEFAULT NULL
 #define Packet_settings_MSGTYPE Settings
@@ -213,30 +875,66 @@ X(a, STATIC,   SINGULAR, BOOL,     ack,               7)
 #define Packet_log_MSGTYPE Log
 #define Packet_request_MSGTYPE Request
 #define Packet_gps_MSGTYPE Gps
-
+#define Packet_stats_MSGTYPE Stats
+#define Packet_log_batch_MSGTYPE LogBatch
+#define Packet_link_test_MSGTYPE LinkTest
+#define Packet_credit_MSGTYPE Credit
+#define Packet_probe_report_MSGTYPE ProbeReport
+#define Packet_link_adapt_MSGTYPE LinkAdapt
+
+extern const pb_msgdesc_t LinkRung_msg;
 extern const pb_msgdesc_t Settings_msg;
 extern const pb_msgdesc_t Transmission_msg;
 extern const pb_msgdesc_t Gps_msg;
+extern const pb_msgdesc_t RssiSummary_msg;
 extern const pb_msgdesc_t Log_msg;
+extern const pb_msgdesc_t LogBatch_msg;
+extern const pb_msgdesc_t Schedule_msg;
 extern const pb_msgdesc_t Request_msg;
+extern const pb_msgdesc_t LinkTest_msg;
+extern const pb_msgdesc_t Credit_msg;
+extern const pb_msgdesc_t Latency_msg;
+extern const pb_msgdesc_t Stats_msg;
+extern const pb_msgdesc_t ProbeReport_msg;
+extern const pb_msgdesc_t LinkAdapt_msg;
 extern const pb_msgdesc_t Packet_msg;
 
 /* Defines for backwards compatibility with code written before nanopb-0.4.0 */
+#define LinkRung_fields &LinkRung_msg
 #define Settings_fields &Settings_msg
 #define Transmission_fields &Transmission_msg
 #define Gps_fields &Gps_msg
+#define RssiSummary_fields &RssiSummary_msg
 #define Log_fields &Log_msg
+#define LogBatch_fields &LogBatch_msg
+#define Schedule_fields &Schedule_msg
 #define Request_fields &Request_msg
+#define LinkTest_fields &LinkTest_msg
+#define Credit_fields &Credit_msg
+#define Latency_fields &Latency_msg
+#define Stats_fields &Stats_msg
+#define ProbeReport_fields &ProbeReport_msg
+#define LinkAdapt_fields &LinkAdapt_msg
 #define Packet_fields &Packet_msg
 
 /* Maximum encoded size of messages (where known) */
-#define Gps_size                                 24
-#define Log_size                                 701
-#define PACKET_PB_H_MAX_SIZE                     Packet_size
-#define Packet_size                              1069
-#define Request_size                             8
-#define Settings_size                            62
-#define Transmission_size                        258
+/* LogBatch_size depends on runtime parameters */
+/* Packet_size depends on runtime parameters */
+#define Credit_size                              24
+#define Gps_size                                 62
+#define Latency_size                             30
+#define LinkAdapt_size                           84
+#define LinkRung_size                            38
+#define LinkTest_size                            282
+#define Log_size                                 1531
+#define PACKET_PB_H_MAX_SIZE                     Log_size
+#define ProbeReport_size                         142
+#define Request_size                             48
+#define RssiSummary_size                         41
+#define Schedule_size                            20
+#define Settings_size                            379
+#define Stats_size                               416
+#define Transmission_size                        264
 
 #ifdef __cplusplus
 } /* extern "C" */
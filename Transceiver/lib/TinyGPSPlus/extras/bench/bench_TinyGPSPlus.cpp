@@ -0,0 +1,168 @@
+// Host benchmark of the TinyGPS++ parse modes on a recorded NMEA stream.
+//
+// Feeds the corpus through one parser in the default mode and one in the fast
+// mode, comparing every encode() result and, after each completed sentence,
+// every committed value. Then times each mode over the whole corpus and
+// reports nanoseconds per character.
+//
+// Usage: bench_TinyGPSPlus corpus.nmea [iterations]
+
+#include "TinyGPS++.h"
+
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+struct Snapshot
+{
+  bool locationValid, locationUpdated;
+  RawDegrees lat, lng;
+  bool dateValid, dateUpdated;
+  uint32_t date;
+  bool timeValid, timeUpdated;
+  uint32_t time;
+  int32_t speed, course, altitude, hdop;
+  bool speedValid, courseValid, altitudeValid, hdopValid;
+  uint32_t satellites;
+  bool satellitesValid;
+  uint32_t chars, withFix, failed, passed;
+};
+
+static Snapshot snapshot(TinyGPSPlus &gps)
+{
+  Snapshot s;
+  s.locationValid = gps.location.isValid();
+  s.locationUpdated = gps.location.isUpdated();
+  s.lat = gps.location.rawLat();
+  s.lng = gps.location.rawLng();
+  s.dateValid = gps.date.isValid();
+  s.dateUpdated = gps.date.isUpdated();
+  s.date = gps.date.value();
+  s.timeValid = gps.time.isValid();
+  s.timeUpdated = gps.time.isUpdated();
+  s.time = gps.time.value();
+  s.speedValid = gps.speed.isValid();
+  s.speed = gps.speed.value();
+  s.courseValid = gps.course.isValid();
+  s.course = gps.course.value();
+  s.altitudeValid = gps.altitude.isValid();
+  s.altitude = gps.altitude.value();
+  s.hdopValid = gps.hdop.isValid();
+  s.hdop = gps.hdop.value();
+  s.satellitesValid = gps.satellites.isValid();
+  s.satellites = gps.satellites.value();
+  s.chars = gps.charsProcessed();
+  s.withFix = gps.sentencesWithFix();
+  s.failed = gps.failedChecksum();
+  s.passed = gps.passedChecksum();
+  return s;
+}
+
+static bool sameDegrees(const RawDegrees &a, const RawDegrees &b)
+{
+  return a.deg == b.deg && a.billionths == b.billionths && a.negative == b.negative;
+}
+
+static bool same(const Snapshot &a, const Snapshot &b)
+{
+  return a.locationValid == b.locationValid && a.locationUpdated == b.locationUpdated &&
+         sameDegrees(a.lat, b.lat) && sameDegrees(a.lng, b.lng) &&
+         a.dateValid == b.dateValid && a.dateUpdated == b.dateUpdated && a.date == b.date &&
+         a.timeValid == b.timeValid && a.timeUpdated == b.timeUpdated && a.time == b.time &&
+         a.speedValid == b.speedValid && a.speed == b.speed &&
+         a.courseValid == b.courseValid && a.course == b.course &&
+         a.altitudeValid == b.altitudeValid && a.altitude == b.altitude &&
+         a.hdopValid == b.hdopValid && a.hdop == b.hdop &&
+         a.satellitesValid == b.satellitesValid && a.satellites == b.satellites &&
+         a.chars == b.chars && a.withFix == b.withFix && a.failed == b.failed && a.passed == b.passed;
+}
+
+// Returns the number of mismatching sentences.
+static size_t verify(const string &corpus)
+{
+  TinyGPSPlus reference;
+  TinyGPSPlus fast;
+  fast.setFastParse(true);
+
+  size_t sentences = 0;
+  size_t mismatches = 0;
+  size_t lineStart = 0;
+  for (size_t i = 0; i < corpus.size(); ++i)
+  {
+    char c = corpus[i];
+    bool a = reference.encode(c);
+    bool b = fast.encode(c);
+    if (a != b || (c == '\n' && !same(snapshot(reference), snapshot(fast))))
+    {
+      if (mismatches++ < 10)
+        cerr << "mismatch at byte " << i << ": " << corpus.substr(lineStart, i + 1 - lineStart);
+    }
+    if (a)
+      ++sentences;
+    if (c == '\n')
+      lineStart = i + 1;
+  }
+  if (!same(snapshot(reference), snapshot(fast)))
+    ++mismatches;
+
+  cout << "verified " << sentences << " valid sentences, " << reference.failedChecksum()
+       << " failed checksums, " << mismatches << " mismatches" << endl;
+  return mismatches;
+}
+
+static double nsPerChar(const string &corpus, bool fastParse, int iterations)
+{
+  uint32_t sink = 0;
+  auto start = chrono::steady_clock::now();
+  for (int i = 0; i < iterations; ++i)
+  {
+    TinyGPSPlus gps;
+    gps.setFastParse(fastParse);
+    for (char c : corpus)
+      sink += gps.encode(c);
+    sink += gps.location.rawLat().billionths;
+  }
+  auto elapsed = chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - start).count();
+  volatile uint32_t keep = sink;
+  (void)keep;
+  return static_cast<double>(elapsed) / (static_cast<double>(corpus.size()) * iterations);
+}
+
+int main(int argc, char **argv)
+{
+  if (argc < 2)
+  {
+    cerr << "usage: " << argv[0] << " corpus.nmea [iterations]" << endl;
+    return 2;
+  }
+  int iterations = argc > 2 ? atoi(argv[2]) : 20;
+
+  ifstream in(argv[1], ios::binary);
+  if (!in)
+  {
+    cerr << "cannot open " << argv[1] << endl;
+    return 2;
+  }
+  stringstream buffer;
+  buffer << in.rdbuf();
+  string corpus = buffer.str();
+  cout << argv[1] << ": " << corpus.size() << " bytes" << endl;
+
+  if (verify(corpus) != 0)
+    return 1;
+
+  // One untimed pass of each to warm the caches.
+  nsPerChar(corpus, false, 1);
+  nsPerChar(corpus, true, 1);
+  double reference = nsPerChar(corpus, false, iterations);
+  double fast = nsPerChar(corpus, true, iterations);
+  cout.precision(2);
+  cout << fixed << "default: " << reference << " ns/char" << endl
+       << "fast:    " << fast << " ns/char (" << reference / fast << "x)" << endl;
+  return 0;
+}
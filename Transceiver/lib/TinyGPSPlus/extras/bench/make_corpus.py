@@ -0,0 +1,91 @@
+"""
+Write a synthetic NMEA recording of a drive, for the TinyGPS++ benchmark.
+
+Stands in for a UART capture: a 10 Hz multi-constellation receiver sending
+GGA, RMC, GSA, GSV, VTG and GLL every epoch and TXT now and then, starting
+without a fix, with occasional sentences torn by a dropped byte.
+
+Usage:
+    python3 make_corpus.py drive.nmea [seconds]
+"""
+
+import math
+import random
+import sys
+
+
+def sentence(body):
+    checksum = 0
+    for ch in body:
+        checksum ^= ord(ch)
+    return f"${body}*{checksum:02X}\r\n"
+
+
+def ddmm(value, positive, negative, width):
+    hemisphere = positive if value >= 0 else negative
+    value = abs(value)
+    degrees = int(value)
+    minutes = (value - degrees) * 60
+    return f"{degrees:0{width}d}{minutes:08.5f}", hemisphere
+
+
+def epoch(t, lat, lon, speed_kn, course, fixed, rng):
+    hh, rem = divmod(int(t), 3600)
+    mm, ss = divmod(rem, 60)
+    cs = int(round((t - int(t)) * 100))
+    stamp = f"{(12 + hh) % 24:02d}{mm:02d}{ss:02d}.{cs:02d}"
+    date = "160526"
+    lat_s, ns = ddmm(lat, "N", "S", 2)
+    lon_s, ew = ddmm(lon, "E", "W", 3)
+    sats = rng.randint(7, 14) if fixed else 0
+    hdop = f"{rng.uniform(0.6, 1.6):.2f}" if fixed else ""
+    alt = f"{52.0 + 3 * math.sin(t / 40):.1f}"
+    out = []
+    if fixed:
+        out.append(f"GNGGA,{stamp},{lat_s},{ns},{lon_s},{ew},1,{sats:02d},{hdop},{alt},M,47.0,M,,")
+        out.append(f"GNRMC,{stamp},A,{lat_s},{ns},{lon_s},{ew},{speed_kn:.3f},{course:.2f},{date},,,A,V")
+    else:
+        out.append(f"GNGGA,{stamp},,,,,0,00,99.99,,,,,,")
+        out.append(f"GNRMC,{stamp},V,,,,,,,{date},,,N,V")
+    out.append("GNGSA,A,3,05,07,13,14,15,17,19,24,30,,,,1.45,0.87,1.16,1")
+    out.append("GNGSA,A,3,65,71,72,86,87,,,,,,,,1.45,0.87,1.16,2")
+    for i in range(1, 4):
+        sats_text = ",".join(
+            f"{rng.randint(1, 32):02d},{rng.randint(5, 85):02d},{rng.randint(0, 359):03d},{rng.randint(20, 48)}"
+            for _ in range(4)
+        )
+        out.append(f"GPGSV,3,{i},12,{sats_text},1")
+    out.append(f"GNVTG,{course:.2f},T,,M,{speed_kn:.3f},N,{speed_kn * 1.852:.3f},K,A")
+    out.append(f"GNGLL,{lat_s},{ns},{lon_s},{ew},{stamp},A,A")
+    if int(t * 10) % 100 == 0:
+        out.append("GPTXT,01,01,02,ANTSTATUS=OK")
+    return [sentence(body) for body in out]
+
+
+def main():
+    path = sys.argv[1]
+    seconds = int(sys.argv[2]) if len(sys.argv) > 2 else 120
+    rng = random.Random(1)
+    lat, lon = 51.4988, -0.1749
+    course = 80.0
+    speed = 0.0
+    with open(path, "w", newline="") as f:
+        for step in range(seconds * 10):
+            t = step / 10
+            fixed = t >= 5
+            if fixed:
+                speed = min(30.0, speed + rng.uniform(-0.5, 0.8))
+                speed = max(0.0, speed)
+                course = (course + rng.uniform(-2, 2)) % 360
+                metres = speed * 0.514444 * 0.1
+                lat += metres * math.cos(math.radians(course)) / 111320
+                lon += metres * math.sin(math.radians(course)) / (111320 * math.cos(math.radians(lat)))
+            for line in epoch(t, lat, lon, speed, course, fixed, rng):
+                if rng.random() < 0.002:
+                    cut = rng.randrange(1, len(line) - 2)
+                    line = line[:cut] + line[cut + 1:]
+                f.write(line)
+
+
+if __name__ == "__main__":
+    main()
@@ -32,6 +32,10 @@ Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
 #define _GNRMCterm   "GNRMC"
 #define _GNGGAterm   "GNGGA"
 
+// Sentence id of the fast mode: the three characters after the talker id
+#define _GPS_ID(a, b, c) (((uint32_t)(uint8_t)(a) << 16) | ((uint32_t)(uint8_t)(b) << 8) | (uint32_t)(uint8_t)(c))
+#define _GPS_ISDIGIT(c) ((uint8_t)((c) - '0') < 10)
+
 TinyGPSPlus::TinyGPSPlus()
   :  parity(0)
   ,  isChecksumTerm(false)
@@ -39,6 +43,8 @@ TinyGPSPlus::TinyGPSPlus()
   ,  curTermNumber(0)
   ,  curTermOffset(0)
   ,  sentenceHasFix(false)
+  ,  fastParse(false)
+  ,  skipSentence(false)
   ,  customElts(0)
   ,  customCandidates(0)
   ,  encodedCharCount(0)
@@ -65,11 +71,18 @@ bool TinyGPSPlus::encode(char c)
   case '\n':
   case '*':
     {
+      if (skipSentence && !isChecksumTerm)
+      {
+        // Nothing to parse; only the checksum term is kept.
+        ++curTermNumber;
+        isChecksumTerm = c == '*';
+        return false;
+      }
       bool isValidSentence = false;
       if (curTermOffset < sizeof(term))
       {
         term[curTermOffset] = 0;
-        isValidSentence = endOfTermHandler();
+        isValidSentence = fastParse ? endOfTermHandlerFast() : endOfTermHandler();
       }
       ++curTermNumber;
       curTermOffset = 0;
@@ -84,9 +97,15 @@ bool TinyGPSPlus::encode(char c)
     curSentenceType = GPS_SENTENCE_OTHER;
     isChecksumTerm = false;
     sentenceHasFix = false;
+    skipSentence = false;
     return false;
 
   default: // ordinary characters
+    if (skipSentence && !isChecksumTerm)
+    {
+      parity ^= c;
+      return false;
+    }
     if (curTermOffset < sizeof(term) - 1)
       term[curTermOffset++] = c;
     if (!isChecksumTerm)
@@ -152,60 +171,65 @@ void TinyGPSPlus::parseDegrees(const char *term, RawDegrees &deg)
   deg.negative = false;
 }
 
-#define COMBINE(sentence_type, term_number) (((unsigned)(sentence_type) << 5) | term_number)
-
-// Processes a just-completed term
-// Returns true if new sentence has just passed checksum test and is validated
-bool TinyGPSPlus::endOfTermHandler()
+// Processes a just-completed checksum term, for both modes
+// Returns true if the sentence passed the checksum test and was committed
+bool TinyGPSPlus::checksumTermHandler()
 {
-  // If it's the checksum term, and the checksum checks out, commit
-  if (isChecksumTerm)
+  byte checksum = 16 * fromHex(term[0]) + fromHex(term[1]);
+  if (checksum == parity)
   {
-    byte checksum = 16 * fromHex(term[0]) + fromHex(term[1]);
-    if (checksum == parity)
+    passedChecksumCount++;
+    if (sentenceHasFix)
+      ++sentencesWithFixCount;
+
+    switch(curSentenceType)
     {
-      passedChecksumCount++;
+    case GPS_SENTENCE_GPRMC:
+      date.commit();
+      time.commit();
       if (sentenceHasFix)
-        ++sentencesWithFixCount;
-
-      switch(curSentenceType)
       {
-      case GPS_SENTENCE_GPRMC:
-        date.commit();
-        time.commit();
-        if (sentenceHasFix)
-        {
-           location.commit();
-           speed.commit();
-           course.commit();
-        }
-        break;
-      case GPS_SENTENCE_GPGGA:
-        time.commit();
-        if (sentenceHasFix)
-        {
-          location.commit();
-          altitude.commit();
-        }
-        satellites.commit();
-        hdop.commit();
-        break;
+         location.commit();
+         speed.commit();
+         course.commit();
       }
-
-      // Commit all custom listeners of this sentence type
-      for (TinyGPSCustom *p = customCandidates; p != NULL && strcmp(p->sentenceName, customCandidates->sentenceName) == 0; p = p->next)
-         p->commit();
-      return true;
+      break;
+    case GPS_SENTENCE_GPGGA:
+      time.commit();
+      if (sentenceHasFix)
+      {
+        location.commit();
+        altitude.commit();
+      }
+      satellites.commit();
+      hdop.commit();
+      break;
     }
 
-    else
-    {
-      ++failedChecksumCount;
-    }
+    // Commit all custom listeners of this sentence type
+    for (TinyGPSCustom *p = customCandidates; p != NULL && strcmp(p->sentenceName, customCandidates->sentenceName) == 0; p = p->next)
+       p->commit();
+    return true;
+  }
 
-    return false;
+  else
+  {
+    ++failedChecksumCount;
   }
 
+  return false;
+}
+
+#define COMBINE(sentence_type, term_number) (((unsigned)(sentence_type) << 5) | term_number)
+
+// Processes a just-completed term
+// Returns true if new sentence has just passed checksum test and is validated
+bool TinyGPSPlus::endOfTermHandler()
+{
+  // If it's the checksum term, and the checksum checks out, commit
+  if (isChecksumTerm)
+    return checksumTermHandler();
+
   // the first term determines the sentence type
   if (curTermNumber == 0)
   {
@@ -281,6 +305,148 @@ bool TinyGPSPlus::endOfTermHandler()
   return false;
 }
 
+// static
+// Single-pass version of parseDecimal: -xxxx.yy in hundredths
+int32_t TinyGPSPlus::parseDecimalFast(const char *term)
+{
+  bool negative = *term == '-';
+  if (negative) ++term;
+  int32_t whole = 0;
+  while (_GPS_ISDIGIT(*term))
+    whole = 10 * whole + (*term++ - '0');
+  int32_t ret = 100 * whole;
+  if (*term == '.' && _GPS_ISDIGIT(term[1]))
+  {
+    ret += 10 * (term[1] - '0');
+    if (_GPS_ISDIGIT(term[2]))
+      ret += term[2] - '0';
+  }
+  return negative ? -ret : ret;
+}
+
+// static
+// Single-pass replacement for atol on NMEA integer terms
+int32_t TinyGPSPlus::parseIntegerFast(const char *term)
+{
+  bool negative = *term == '-';
+  if (negative) ++term;
+  int32_t ret = 0;
+  while (_GPS_ISDIGIT(*term))
+    ret = 10 * ret + (*term++ - '0');
+  return negative ? -ret : ret;
+}
+
+// static
+// Single-pass version of parseDegrees: DDMM.MMMM
+void TinyGPSPlus::parseDegreesFast(const char *term, RawDegrees &deg)
+{
+  uint32_t leftOfDecimal = 0;
+  while (_GPS_ISDIGIT(*term))
+    leftOfDecimal = 10 * leftOfDecimal + (*term++ - '0');
+  uint32_t multiplier = 10000000UL;
+  uint32_t tenMillionthsOfMinutes = (leftOfDecimal % 100) * multiplier;
+
+  deg.deg = (int16_t)(leftOfDecimal / 100);
+
+  if (*term == '.')
+    while (_GPS_ISDIGIT(*++term))
+    {
+      multiplier /= 10;
+      tenMillionthsOfMinutes += (*term - '0') * multiplier;
+    }
+
+  deg.billionths = (5 * tenMillionthsOfMinutes + 1) / 3;
+  deg.negative = false;
+}
+
+// Fast-mode endOfTermHandler: same effects, without string compares or atol
+bool TinyGPSPlus::endOfTermHandlerFast()
+{
+  if (isChecksumTerm)
+    return checksumTermHandler();
+
+  if (curTermNumber == 0)
+  {
+    curSentenceType = GPS_SENTENCE_OTHER;
+    if (curTermOffset == 5 && term[0] == 'G' && (term[1] == 'P' || term[1] == 'N'))
+      switch (_GPS_ID(term[2], term[3], term[4]))
+    {
+      case _GPS_ID('R', 'M', 'C'):
+        curSentenceType = GPS_SENTENCE_GPRMC;
+        break;
+      case _GPS_ID('G', 'G', 'A'):
+        curSentenceType = GPS_SENTENCE_GPGGA;
+        break;
+    }
+
+    customCandidates = NULL;
+    if (customElts != NULL)
+    {
+      for (customCandidates = customElts; customCandidates != NULL && strcmp(customCandidates->sentenceName, term) < 0; customCandidates = customCandidates->next);
+      if (customCandidates != NULL && strcmp(customCandidates->sentenceName, term) > 0)
+         customCandidates = NULL;
+    }
+
+    skipSentence = curSentenceType == GPS_SENTENCE_OTHER && customCandidates == NULL;
+    return false;
+  }
+
+  if (curSentenceType != GPS_SENTENCE_OTHER && term[0])
+    switch(COMBINE(curSentenceType, curTermNumber))
+  {
+    case COMBINE(GPS_SENTENCE_GPRMC, 1): // Time in both sentences
+    case COMBINE(GPS_SENTENCE_GPGGA, 1):
+      time.newTime = (uint32_t)parseDecimalFast(term);
+      break;
+    case COMBINE(GPS_SENTENCE_GPRMC, 2): // GPRMC validity
+      sentenceHasFix = term[0] == 'A';
+      break;
+    case COMBINE(GPS_SENTENCE_GPRMC, 3): // Latitude
+    case COMBINE(GPS_SENTENCE_GPGGA, 2):
+      parseDegreesFast(term, location.rawNewLatData);
+      break;
+    case COMBINE(GPS_SENTENCE_GPRMC, 4): // N/S
+    case COMBINE(GPS_SENTENCE_GPGGA, 3):
+      location.rawNewLatData.negative = term[0] == 'S';
+      break;
+    case COMBINE(GPS_SENTENCE_GPRMC, 5): // Longitude
+    case COMBINE(GPS_SENTENCE_GPGGA, 4):
+      parseDegreesFast(term, location.rawNewLngData);
+      break;
+    case COMBINE(GPS_SENTENCE_GPRMC, 6): // E/W
+    case COMBINE(GPS_SENTENCE_GPGGA, 5):
+      location.rawNewLngData.negative = term[0] == 'W';
+      break;
+    case COMBINE(GPS_SENTENCE_GPRMC, 7): // Speed (GPRMC)
+      speed.newval = parseDecimalFast(term);
+      break;
+    case COMBINE(GPS_SENTENCE_GPRMC, 8): // Course (GPRMC)
+      course.newval = parseDecimalFast(term);
+      break;
+    case COMBINE(GPS_SENTENCE_GPRMC, 9): // Date (GPRMC)
+      date.newDate = (uint32_t)parseIntegerFast(term);
+      break;
+    case COMBINE(GPS_SENTENCE_GPGGA, 6): // Fix data (GPGGA)
+      sentenceHasFix = term[0] > '0';
+      break;
+    case COMBINE(GPS_SENTENCE_GPGGA, 7): // Satellites used (GPGGA)
+      satellites.newval = (uint32_t)parseIntegerFast(term);
+      break;
+    case COMBINE(GPS_SENTENCE_GPGGA, 8): // HDOP
+      hdop.newval = parseDecimalFast(term);
+      break;
+    case COMBINE(GPS_SENTENCE_GPGGA, 9): // Altitude (GPGGA)
+      altitude.newval = parseDecimalFast(term);
+      break;
+  }
+
+  for (TinyGPSCustom *p = customCandidates; p != NULL && strcmp(p->sentenceName, customCandidates->sentenceName) == 0 && p->termNumber <= curTermNumber; p = p->next)
+    if (p->termNumber == curTermNumber)
+         p->set(term);
+
+  return false;
+}
+
 /* static */
 double TinyGPSPlus::distanceBetween(double lat1, double long1, double lat2, double long2)
 {
@@ -241,6 +241,15 @@ public:
   static int32_t parseDecimal(const char *term);
   static void parseDegrees(const char *term, RawDegrees &deg);
 
+  // Fast mode: sentence ids are matched with one switch, each term is parsed
+  // in a single fixed-point pass, and the terms of sentences nobody listens
+  // to are only checksummed. Results are the same as the default mode's.
+  void setFastParse(bool enable) { fastParse = enable; }
+  bool isFastParse() const { return fastParse; }
+  static int32_t parseDecimalFast(const char *term);
+  static int32_t parseIntegerFast(const char *term);
+  static void parseDegreesFast(const char *term, RawDegrees &deg);
+
   uint32_t charsProcessed()   const { return encodedCharCount; }
   uint32_t sentencesWithFix() const { return sentencesWithFixCount; }
   uint32_t failedChecksum()   const { return failedChecksumCount; }
@@ -257,6 +266,8 @@ private:
   uint8_t curTermNumber;
   uint8_t curTermOffset;
   bool sentenceHasFix;
+  bool fastParse;
+  bool skipSentence;
 
   // custom element support
   friend class TinyGPSCustom;
@@ -273,6 +284,8 @@ private:
   // internal utilities
   int fromHex(char a);
   bool endOfTermHandler();
+  bool endOfTermHandlerFast();
+  bool checksumTermHandler();
 };
 
 #endif // def(__TinyGPSPlus_h)
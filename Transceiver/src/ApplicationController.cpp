@@ -13,11 +13,19 @@
  * @param mRadioMgr Reference to the RadioManager.
  * @param mSerialMgr Reference to the SerialTaskManager.
  * @param mSettingsMgr Reference to the SettingsManager.
+ * @param mSerialTx Reference to the SerialTxManager.
+ * @param mLinkMgr Reference to the LinkManager.
+ * @param mScheduler Reference to the TxScheduler.
+ * @param mGpsMgr Reference to the GpsManager.
  */
 ApplicationController::ApplicationController(
     RadioManager &mRadioMgr,
     SerialTaskManager &mSerialMgr,
-    SettingsManager &mSettingsMgr) : mRadioMgr(mRadioMgr), mSerialMgr(mSerialMgr), mSettingsMgr(mSettingsMgr), mRunning(false) {}
+    SettingsManager &mSettingsMgr,
+    SerialTxManager &mSerialTx,
+    LinkManager &mLinkMgr,
+    TxScheduler &mScheduler,
+    GpsManager &mGpsMgr) : mRadioMgr(mRadioMgr), mSerialMgr(mSerialMgr), mSettingsMgr(mSettingsMgr), mSerialTx(mSerialTx), mLinkMgr(mLinkMgr), mScheduler(mScheduler), mGpsMgr(mGpsMgr), mRunning(false) {}
 
 /**
  * @brief Initializes the application controller and its components.
@@ -26,6 +34,12 @@ void ApplicationController::initialize()
 {
     // Initialize components
 
+    if (!mSerialTx.begin())
+    {
+        Serial.println("Failed to initialize serial TX manager!");
+        return;
+    }
+
     if (!mSettingsMgr.initialize())
     {
         Serial.println("Failed to initialize settings manager!\nSettings may be bad!");
@@ -38,12 +52,24 @@ void ApplicationController::initialize()
         return;
     }
 
+    if (!mGpsMgr.begin())
+    {
+        Serial.println("Failed to initialize GPS manager!");
+        return;
+    }
+
     if (!mRadioMgr.initialize(mSettingsMgr))
     {
         Serial.println("Failed to initialize radio!");
         return;
     }
 
+    if (!mScheduler.begin())
+    {
+        Serial.println("Failed to initialize TX scheduler!");
+        return;
+    }
+
     mRunning = true;
     Serial.println("Application controller initialized");
     mSettingsMgr.print();
@@ -58,14 +84,16 @@ void ApplicationController::run()
         return;
 
     // Process incoming serial messages
-    ProtoData *received = nullptr;
+    ProtoData received;
     if (xQueueReceive(mSerialMgr.getQueue(), &received, 0) == pdPASS)
     {
         processProtoMessage(received);
-        delete[] received->buffer;
-        delete received;
+        mSerialMgr.release(received.slot);
     }
 
+    // Fall back to the previous baud rate if the host never committed a new one
+    mLinkMgr.poll();
+
     // Handle current operation mode
     switch (mRadioMgr.getState())
     {
@@ -85,12 +113,14 @@ void ApplicationController::run()
 
 /**
  * @brief Processes a received protobuf message.
- * @param data Pointer to the ProtoData containing the message.
+ * @param data Reference to the ProtoData locating the message in the frame pool.
  */
-void ApplicationController::processProtoMessage(ProtoData *data)
+void ApplicationController::processProtoMessage(const ProtoData &data)
 {
-    Packet packet = Packet_init_zero;
-    pb_istream_t stream = pb_istream_from_buffer(data->buffer, data->length);
+    // Decoded into a member: the transmit path below it needs the loop stack.
+    Packet &packet = mRequest;
+    memset(&packet, 0, sizeof(packet)); // Packet_init_zero, without a temporary on the stack
+    pb_istream_t stream = pb_istream_from_buffer(mSerialMgr.frame(data.slot), data.length);
 
     if (!pb_decode(&stream, Packet_fields, &packet))
     {
@@ -105,9 +135,22 @@ void ApplicationController::processProtoMessage(ProtoData *data)
         flashLed();
         Serial.println("Updated LoRa settings");
     }
-    else if (packet.type == PacketType_TRANSMISSION && packet.has_transmission && mRadioMgr.getState() == State_TRANSMITTER)
+    else if (packet.type == PacketType_TRANSMISSION && packet.has_transmission)
     {
-        mRadioMgr.transmit(packet.transmission.payload.bytes, packet.transmission.payload.size);
+        // Every transmission is answered, so the host always knows whether it was taken.
+        uint32_t evicted = 0;
+        bool accepted = mRadioMgr.getState() == State_TRANSMITTER && !mScheduler.isRunning() &&
+                        mRadioMgr.queueTransmission(packet.transmission.payload.bytes, packet.transmission.payload.size, evicted);
+        sendCredit(packet.transmission.sequence, accepted, evicted);
+        if (accepted)
+        {
+            mCommandLatency.add(micros() - data.rxTimeUs);
+            drainTxQueue();
+        }
+    }
+    else if (packet.type == PacketType_LINK_TEST && packet.has_link_test)
+    {
+        mLinkMgr.echo(packet.link_test, data.length, data.rxTimeUs);
     }
     else if (packet.type == PacketType_REQUEST && packet.has_request)
     {
@@ -119,6 +162,7 @@ void ApplicationController::processProtoMessage(ProtoData *data)
         if (packet.request.stateChange != mRadioMgr.getState())
         {
             flashLed();
+            mScheduler.stop();
             mRadioMgr.standby();
             mRadioMgr.setState(packet.request.stateChange);
         }
@@ -127,9 +171,114 @@ void ApplicationController::processProtoMessage(ProtoData *data)
             flashLed();
             mRadioMgr.TxSerialGPSPacket();
         }
+        if (packet.request.framing != Framing_FRAMING_UNCHANGED)
+        {
+            // Acknowledge in the old framing, then switch both directions over.
+            sendAck();
+            FrameCodec::setMode(packet.request.framing);
+        }
+        if (packet.request.stats == true)
+        {
+            sendStats();
+        }
+        if (packet.request.credit_poll != 0)
+        {
+            // Sent in order behind every earlier ACK, so the host can tell which of those were lost.
+            sendCredit(packet.request.credit_poll, false, 0);
+        }
+        if (packet.request.baud_rate != 0)
+        {
+            // Acknowledge at the old rate; the switch is queued behind the ACK.
+            bool supported = LinkManager::isSupportedBaudRate(packet.request.baud_rate);
+            sendAck(supported);
+            if (supported)
+            {
+                mLinkMgr.changeBaudRate(packet.request.baud_rate);
+            }
+        }
+        if (packet.request.baud_commit == true)
+        {
+            mLinkMgr.commitBaudRate();
+            sendAck();
+        }
+        if (packet.request.has_schedule)
+        {
+            // A zero period stops the schedule; anything else (re)starts it.
+            if (packet.request.schedule.period_us == 0)
+            {
+                mScheduler.stop();
+                sendAck();
+            }
+            else
+            {
+                sendAck(mRadioMgr.getState() == State_TRANSMITTER && mScheduler.start(packet.request.schedule));
+            }
+        }
+    }
+}
+
+/**
+ * @brief Sends an ACK packet to the host.
+ * @param ack False to reject the request instead.
+ */
+void ApplicationController::sendAck(bool ack)
+{
+    Packet &packet = mSerialTx.reply();
+    packet.type = PacketType_ACK;
+    packet.ack = ack;
+    mSerialTx.sendPacket(packet);
+}
+
+/**
+ * @brief Sends an ACK advertising the free TX queue slots to the host.
+ * @details The host keeps at most that many transmissions in flight past this ACK.
+ * @param sequence Sequence number of the transmission or credit poll being answered, or 0 for a window update.
+ * @param accepted Whether the transmission was queued.
+ * @param evicted Number of older queued transmissions discarded to make room for it.
+ */
+void ApplicationController::sendCredit(uint32_t sequence, bool accepted, uint32_t evicted)
+{
+    Packet &packet = mSerialTx.reply();
+    packet.type = PacketType_ACK;
+    packet.ack = accepted;
+    packet.has_credit = true;
+    packet.credit.sequence = sequence;
+    packet.credit.credits = mRadioMgr.txQueueFree();
+    packet.credit.capacity = RadioManager::TX_QUEUE_DEPTH;
+    packet.credit.evicted = evicted;
+    mWindowClosed = packet.credit.credits == 0;
+    mSerialTx.sendPacket(packet);
+}
+
+/**
+ * @brief Starts the next queued transmission and reopens the host's window if it was closed.
+ */
+void ApplicationController::drainTxQueue()
+{
+    if (mRadioMgr.serviceTxQueue() && mWindowClosed)
+    {
+        sendCredit(0, true, 0);
     }
 }
 
+/**
+ * @brief Sends the link and buffer counters to the host.
+ */
+void ApplicationController::sendStats()
+{
+    Packet &packet = mSerialTx.reply();
+    packet.type = PacketType_STATS;
+    packet.has_stats = true;
+    mSerialMgr.fillStats(packet.stats);
+    mSerialTx.fillStats(packet.stats);
+    mRadioMgr.fillStats(packet.stats);
+    mScheduler.fillStats(packet.stats);
+    mGpsMgr.fillStats(packet.stats);
+    packet.stats.has_command_latency = true;
+    mCommandLatency.fill(packet.stats.command_latency);
+    mSerialTx.sendPacket(packet);
+}
+
 /**
  * @brief Updates the LoRa settings with new values.
  * @param newSettings Reference to the new Settings structure.
@@ -157,11 +306,17 @@ void ApplicationController::updateLoraSettings(const Settings &newSettings)
  */
 void ApplicationController::handleTransmissionMode()
 {
-    // Continuous transmission logic
-    if (mRadioMgr.isTransmitted())
+    // Polls the receiver for link feedback between transmissions when adaptation is on
+    mRadioMgr.pollLinkAdaptation();
+
+    // The schedule owns the radio while it runs, from its own task; otherwise keep it busy with queued payloads
+    if (mScheduler.takeFinished())
     {
-        // Add transmission logic here
+        sendStats();
     }
+    if (mScheduler.isRunning())
+        return;
+    drainTxQueue();
 }
 
 /**
@@ -169,8 +324,9 @@ void ApplicationController::handleTransmissionMode()
  */
 void ApplicationController::handleReceptionMode()
 {
-    // Continuous reception logic
-    mRadioMgr.processReceptionLog();
+    // Continuous reception logic; a no-op unless reception runs in the loop
+    mRadioMgr.pollReception();
+    mRadioMgr.pollLinkAdaptation();
 
     if (mRadioMgr.isReceived())
     {
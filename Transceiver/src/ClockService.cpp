@@ -0,0 +1,199 @@
+/**
+ * @file ClockService.cpp
+ * @brief Keeps a UTC microsecond clock on top of esp_timer, disciplined by GNSS time and PPS.
+ */
+
+#include "ClockService.h"
+
+ClockService *ClockService::instance = nullptr;
+
+/**
+ * @brief Constructor for ClockService.
+ */
+ClockService::ClockService()
+{
+    instance = this;
+}
+
+/**
+ * @brief Starts timing the PPS edges, on boards where the pulse is wired.
+ */
+void ClockService::begin()
+{
+#ifdef GPS_PPS_PIN
+    pinMode(GPS_PPS_PIN, INPUT);
+    attachInterrupt(digitalPinToInterrupt(GPS_PPS_PIN), ppsISR, RISING);
+#endif
+}
+
+/**
+ * @brief PPS ISR, records the edge for the next GNSS time.
+ */
+void IRAM_ATTR ClockService::ppsISR()
+{
+    if (!instance)
+        return;
+
+    int64_t now = esp_timer_get_time();
+    portENTER_CRITICAL_ISR(&instance->mMux);
+    instance->mPpsUs = now;
+    instance->mPpsEdges++;
+    portEXIT_CRITICAL_ISR(&instance->mMux);
+}
+
+/**
+ * @brief Takes a valid UTC time from a GNSS message; called by the GPS task.
+ * @details With a recent PPS edge, the edge is the reference point and the
+ *          message only names its second: the message's time, less how long
+ *          after the edge it arrived, rounds to that second as long as the
+ *          module's output delay is under half a second. At high fix rates
+ *          several messages follow one edge; only the first is used.
+ * @param utcUs UTC of the navigation epoch, microseconds since 1970.
+ * @param localUs esp_timer_get_time() when the message was parsed.
+ */
+void ClockService::onGnssTime(int64_t utcUs, int64_t localUs)
+{
+    portENTER_CRITICAL(&mMux);
+    int64_t ppsUs = mPpsUs;
+    portEXIT_CRITICAL(&mMux);
+
+    if (ppsUs && localUs - ppsUs < PPS_PAIR_US)
+    {
+        if (ppsUs == mPairedPpsUs)
+            return;
+        mPairedPpsUs = ppsUs;
+        int64_t edgeUs = utcUs - (localUs - ppsUs);
+        int64_t second = (edgeUs + 500000) / 1000000;
+        discipline(ppsUs, second * 1000000, PPS_ERROR_US, ClockSource_CLOCK_PPS);
+        return;
+    }
+
+    // A PPS reference point stays better than a message time for a long holdover.
+    uint64_t ignored;
+    uint32_t errorUs;
+    if (toUtc(localUs, ignored, errorUs) == ClockSource_CLOCK_PPS && errorUs < MESSAGE_ERROR_US)
+        return;
+    discipline(localUs, utcUs, MESSAGE_ERROR_US, ClockSource_CLOCK_GNSS);
+}
+
+/**
+ * @brief Moves the reference point and, between PPS edges, measures the oscillator.
+ * @param localUs esp_timer_get_time() of the new reference point.
+ * @param utcUs UTC of the new reference point.
+ * @param errorUs Error of the new reference point.
+ * @param source What the reference point came from.
+ */
+void ClockService::discipline(int64_t localUs, int64_t utcUs, uint32_t errorUs, ClockSource source)
+{
+    portENTER_CRITICAL(&mMux);
+    if (source == ClockSource_CLOCK_PPS && mSource == ClockSource_CLOCK_PPS && localUs > mBaseLocalUs)
+    {
+        int64_t elapsedUs = localUs - mBaseLocalUs;
+        int64_t predictedUs = mBaseUtcUs + elapsedUs + static_cast<int64_t>(elapsedUs * mFrequency);
+        int64_t phaseUs = utcUs - predictedUs;
+        if (phaseUs > -STEP_US && phaseUs < STEP_US)
+        {
+            double measured = static_cast<double>(utcUs - mBaseUtcUs - elapsedUs) / elapsedUs;
+            mFrequency = mFrequencyKnown ? mFrequency + FREQUENCY_GAIN * (measured - mFrequency) : measured;
+            mFrequencyKnown = true;
+        }
+        else
+        {
+            mSteps++;
+        }
+    }
+    else if (source != mSource)
+    {
+        mSteps++;
+    }
+    mSource = source;
+    mBaseLocalUs = localUs;
+    mBaseUtcUs = utcUs;
+    mBaseErrorUs = errorUs;
+    portEXIT_CRITICAL(&mMux);
+}
+
+/**
+ * @brief Converts an esp_timer_get_time() value to UTC.
+ * @param localUs esp_timer_get_time() value.
+ * @param utcUs Set to the UTC, microseconds since 1970, or left at localUs before any GNSS time.
+ * @param errorUs Set to the estimated error, UINT32_MAX before any GNSS time.
+ * @return What the clock is disciplined by; CLOCK_LOCAL if utcUs is not UTC.
+ */
+ClockSource ClockService::toUtc(int64_t localUs, uint64_t &utcUs, uint32_t &errorUs) const
+{
+    portENTER_CRITICAL(&mMux);
+    ClockSource source = mSource;
+    int64_t baseLocalUs = mBaseLocalUs;
+    int64_t baseUtcUs = mBaseUtcUs;
+    uint32_t baseErrorUs = mBaseErrorUs;
+    double frequency = mFrequency;
+    bool frequencyKnown = mFrequencyKnown;
+    portEXIT_CRITICAL(&mMux);
+
+    if (source == ClockSource_CLOCK_LOCAL)
+    {
+        utcUs = localUs;
+        errorUs = UINT32_MAX;
+        return source;
+    }
+
+    int64_t elapsedUs = localUs - baseLocalUs;
+    utcUs = baseUtcUs + elapsedUs + static_cast<int64_t>(elapsedUs * frequency);
+    uint64_t driftUs = static_cast<uint64_t>(elapsedUs < 0 ? -elapsedUs : elapsedUs) * (frequencyKnown ? MEASURED_PPM : HOLDOVER_PPM) / 1000000;
+    errorUs = static_cast<uint32_t>(std::min<uint64_t>(baseErrorUs + driftUs, UINT32_MAX));
+    return source;
+}
+
+/**
+ * @brief Reads the clock now.
+ * @return UTC in microseconds since 1970, or esp_timer_get_time() before any GNSS time.
+ */
+uint64_t ClockService::nowUs() const
+{
+    uint64_t utcUs;
+    uint32_t errorUs;
+    toUtc(esp_timer_get_time(), utcUs, errorUs);
+    return utcUs;
+}
+
+/**
+ * @brief Fills the clock fields of a Stats message.
+ * @param stats Reference to the Stats structure to be filled.
+ */
+void ClockService::fillStats(Stats &stats) const
+{
+    uint64_t utcUs;
+    stats.clock_source = toUtc(esp_timer_get_time(), utcUs, stats.clock_error_us);
+
+    portENTER_CRITICAL(&mMux);
+    stats.pps_edges = mPpsEdges;
+    stats.clock_steps = mSteps;
+    stats.clock_drift_ppm = mFrequencyKnown ? static_cast<float>(mFrequency * 1e6) : 0;
+    portEXIT_CRITICAL(&mMux);
+}
+
+/**
+ * @brief Converts a UTC calendar time to microseconds since 1970.
+ * @param year Year, e.g. 2024.
+ * @param month Month, 1-12.
+ * @param day Day of the month, 1-31.
+ * @param hour Hour, 0-23.
+ * @param minute Minute, 0-59.
+ * @param second Second, 0-60.
+ * @param nanos Fraction of the second in nanoseconds, may be negative.
+ * @return Microseconds since 1970-01-01 00:00:00 UTC.
+ */
+int64_t ClockService::utcMicros(uint16_t year, uint8_t month, uint8_t day, uint8_t hour, uint8_t minute, uint8_t second, int32_t nanos)
+{
+    // Days from the civil date, counting years from March so the leap day comes last.
+    int32_t y = year - (month <= 2);
+    int32_t era = (y >= 0 ? y : y - 399) / 400;
+    uint32_t yearOfEra = static_cast<uint32_t>(y - era * 400);
+    uint32_t dayOfYear = (153 * (month + (month > 2 ? -3 : 9)) + 2) / 5 + day - 1;
+    uint32_t dayOfEra = yearOfEra * 365 + yearOfEra / 4 - yearOfEra / 100 + dayOfYear;
+    int64_t days = static_cast<int64_t>(era) * 146097 + dayOfEra - 719468;
+
+    int64_t seconds = days * 86400 + hour * 3600 + minute * 60 + second;
+    return seconds * 1000000 + nanos / 1000;
+}
@@ -0,0 +1,287 @@
+/**
+ * @file FrameCodec.cpp
+ * @brief Encodes and incrementally decodes framed protobuf messages on the host serial link.
+ */
+
+#include "FrameCodec.h"
+
+volatile Framing FrameCodec::sMode = Framing_FRAMING_DELIMITED;
+
+/**
+ * @brief Computes the CRC-16/CCITT-FALSE checksum of a buffer.
+ * @param data Pointer to the data.
+ * @param length Length of the data.
+ * @param crc Initial CRC value.
+ * @return The CRC of the data.
+ */
+uint16_t FrameCodec::crc16(const uint8_t *data, size_t length, uint16_t crc)
+{
+    for (size_t i = 0; i < length; ++i)
+    {
+        crc ^= static_cast<uint16_t>(data[i]) << 8;
+        for (int bit = 0; bit < 8; ++bit)
+        {
+            crc = (crc & 0x8000) ? (crc << 1) ^ 0x1021 : crc << 1;
+        }
+    }
+    return crc;
+}
+
+/**
+ * @brief Frames a payload in the given wire format.
+ * @param mode Framing to use.
+ * @param data Pointer to the payload.
+ * @param length Length of the payload.
+ * @param out Destination buffer for the framed bytes.
+ * @param capacity Capacity of the destination buffer.
+ * @return Number of framed bytes written, or 0 if the destination is too small.
+ */
+size_t FrameCodec::encode(Framing mode, const uint8_t *data, size_t length, uint8_t *out, size_t capacity)
+{
+    if (capacity < maxEncodedSize(length))
+        return 0;
+
+    if (mode != Framing_FRAMING_COBS)
+    {
+        memcpy(out, START_DELIMITER, START_LEN);
+        memcpy(out + START_LEN, data, length);
+        memcpy(out + START_LEN + length, END_DELIMITER, END_LEN);
+        return START_LEN + length + END_LEN;
+    }
+
+    uint16_t crc = crc16(data, length);
+    uint8_t trailer[CRC_LEN] = {static_cast<uint8_t>(crc & 0xFF), static_cast<uint8_t>(crc >> 8)};
+
+    // Leading delimiter flushes any debug text printed since the last frame.
+    size_t written = 0;
+    out[written++] = 0x00;
+    size_t codeIndex = written++;
+    uint8_t code = 1;
+    for (size_t i = 0; i < length + CRC_LEN; ++i)
+    {
+        uint8_t byte = i < length ? data[i] : trailer[i - length];
+        if (byte == 0)
+        {
+            out[codeIndex] = code;
+            codeIndex = written++;
+            code = 1;
+            continue;
+        }
+
+        out[written++] = byte;
+        if (++code == 0xFF)
+        {
+            out[codeIndex] = code;
+            codeIndex = written++;
+            code = 1;
+        }
+    }
+    out[codeIndex] = code;
+    out[written++] = 0x00;
+    return written;
+}
+
+/**
+ * @brief Constructor for FrameDecoder.
+ * @param buffer Destination for decoded payloads.
+ * @param capacity Capacity of the destination buffer.
+ */
+FrameDecoder::FrameDecoder(uint8_t *buffer, size_t capacity)
+    : mBuffer(buffer), mCapacity(capacity) {}
+
+/**
+ * @brief Drops any partially decoded frame and waits for the next one.
+ */
+void FrameDecoder::reset()
+{
+    mInFrame = false;
+    mDiscard = false;
+    mStartMatch = 0;
+    mEndMatch = 0;
+    beginFrame();
+}
+
+/**
+ * @brief Feeds a single received byte to the decoder.
+ * @details Runs in constant time per byte. The start delimiter is recognised in
+ *          every mode so a host speaking the legacy format can always resync, but in
+ *          COBS mode only as the first bytes after a delimiter: COBS does not escape
+ *          "<START>", so inside a frame it is payload.
+ * @param byte The received byte.
+ * @return True if a complete, verified frame is available via data()/length().
+ */
+bool FrameDecoder::push(uint8_t byte)
+{
+    if (mMode != Framing_FRAMING_COBS)
+    {
+        mStartMatch = advanceMatch(mStartMatch, byte, FrameCodec::START_DELIMITER);
+    }
+    else if (mAtBoundary)
+    {
+        // The bytes still go to the COBS decoder below in case this is not the delimiter.
+        bool extends = byte == static_cast<uint8_t>(FrameCodec::START_DELIMITER[mStartMatch]);
+        mStartMatch = extends ? mStartMatch + 1 : 0;
+        mAtBoundary = extends;
+    }
+
+    if (mStartMatch == FrameCodec::START_LEN)
+    {
+        // A start delimiter always opens a new delimited frame, dropping whatever came before it.
+        mStartMatch = 0;
+        mMode = Framing_FRAMING_DELIMITED;
+        FrameCodec::setMode(Framing_FRAMING_DELIMITED);
+        mInFrame = true;
+        mDiscard = false;
+        mEndMatch = 0;
+        beginFrame();
+        return false;
+    }
+
+    if (mMode == Framing_FRAMING_COBS)
+        return pushCobs(byte);
+    return pushDelimited(byte);
+}
+
+/**
+ * @brief Advances an incremental delimiter match by one byte.
+ * @details Neither delimiter repeats its leading '<', so a mismatch can only restart on '<'.
+ * @param matched Number of delimiter bytes matched so far.
+ * @param byte The received byte.
+ * @param delimiter The delimiter being matched.
+ * @return The new number of matched bytes.
+ */
+size_t FrameDecoder::advanceMatch(size_t matched, uint8_t byte, const char *delimiter)
+{
+    if (byte == static_cast<uint8_t>(delimiter[matched]))
+        return matched + 1;
+    return byte == static_cast<uint8_t>(delimiter[0]) ? 1 : 0;
+}
+
+/**
+ * @brief Decodes one byte of a legacy <START>payload<END> frame.
+ * @param byte The received byte.
+ * @return True if the frame is complete.
+ */
+bool FrameDecoder::pushDelimited(uint8_t byte)
+{
+    if (!mInFrame)
+    {
+        // Switch over to COBS at a frame boundary once it has been negotiated.
+        if (FrameCodec::mode() == Framing_FRAMING_COBS)
+        {
+            mMode = Framing_FRAMING_COBS;
+            beginFrame();
+            return pushCobs(byte);
+        }
+        return false;
+    }
+
+    if (!append(byte))
+    {
+        mOverflows++;
+        mInFrame = false;
+        return false;
+    }
+
+    mEndMatch = advanceMatch(mEndMatch, byte, FrameCodec::END_DELIMITER);
+    if (mEndMatch < FrameCodec::END_LEN)
+        return false;
+
+    mEndMatch = 0;
+    mInFrame = false;
+    mLength = mIndex - FrameCodec::END_LEN;
+    if (mLength == 0)
+        return false;
+
+    mFrames++;
+    return true;
+}
+
+/**
+ * @brief Decodes one byte of a COBS frame and verifies its CRC on the delimiter.
+ * @param byte The received byte.
+ * @return True if the frame is complete and its CRC matches.
+ */
+bool FrameDecoder::pushCobs(uint8_t byte)
+{
+    if (byte == 0x00)
+    {
+        bool discarded = mDiscard;
+        bool truncated = mCobsRemaining != 0;
+        size_t length = mIndex;
+        beginFrame();
+
+        if (FrameCodec::mode() != Framing_FRAMING_COBS)
+            mMode = Framing_FRAMING_DELIMITED;
+
+        if (discarded || length == 0)
+            return false;
+        if (truncated || length <= FrameCodec::CRC_LEN)
+        {
+            mMalformed++;
+            return false;
+        }
+
+        mLength = length - FrameCodec::CRC_LEN;
+        uint16_t expected = mBuffer[mLength] | (mBuffer[mLength + 1] << 8);
+        if (FrameCodec::crc16(mBuffer, mLength) != expected)
+        {
+            mCrcErrors++;
+            return false;
+        }
+
+        mFrames++;
+        return true;
+    }
+
+    if (mDiscard)
+        return false;
+
+    bool ok;
+    if (mCobsRemaining == 0)
+    {
+        // Code byte: emit the zero that terminated the previous block, if any.
+        ok = !mCobsPendingZero || append(0x00);
+        mCobsRemaining = byte - 1;
+        mCobsPendingZero = byte != 0xFF;
+    }
+    else
+    {
+        ok = append(byte);
+        mCobsRemaining--;
+    }
+
+    if (!ok)
+    {
+        // Only this frame is lost; decoding resumes after the next delimiter.
+        mOverflows++;
+        mDiscard = true;
+    }
+    return false;
+}
+
+/**
+ * @brief Appends a decoded byte to the destination buffer.
+ * @param byte The decoded byte.
+ * @return False if the buffer is full.
+ */
+bool FrameDecoder::append(uint8_t byte)
+{
+    if (mIndex >= mCapacity)
+        return false;
+    mBuffer[mIndex++] = byte;
+    return true;
+}
+
+/**
+ * @brief Resets the per-frame decoding state.
+ */
+void FrameDecoder::beginFrame()
+{
+    mIndex = 0;
+    mCobsRemaining = 0;
+    mCobsPendingZero = false;
+    mDiscard = false;
+    mAtBoundary = true;
+    mStartMatch = 0;
+}
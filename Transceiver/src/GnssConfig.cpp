@@ -0,0 +1,325 @@
+/**
+ * @file GnssConfig.cpp
+ * @brief Negotiates the fix rate and output protocol of the GNSS module at start-up.
+ */
+
+#include "GnssConfig.h"
+
+namespace
+{
+/// Navigation intervals tried, fastest first.
+const uint32_t INTERVALS_MS[] = {100, 200, 250, 500, 1000};
+
+constexpr uint8_t UBX_PORT_UART1 = 1;            ///< CFG-PRT port id of the UART the module is wired to
+constexpr uint32_t UBX_MODE_8N1 = 0x000008D0;    ///< CFG-PRT mode: 8 data bits, no parity, 1 stop bit
+constexpr uint16_t UBX_PROTO_UBX = 0x0001;       ///< CFG-PRT protocol mask bit for UBX
+constexpr uint16_t UBX_PROTO_NMEA = 0x0002;      ///< CFG-PRT protocol mask bit for NMEA
+constexpr uint8_t UBX_CLASS_NMEA = 0xF0;         ///< Class of the standard NMEA messages in CFG-MSG
+const uint8_t UBX_NMEA_EXTRA[] = {0x01, 0x02, 0x03, 0x05}; ///< GLL, GSA, GSV and VTG, not needed for a fix
+
+void writeLe(uint8_t *data, uint32_t value, size_t size)
+{
+    for (size_t i = 0; i < size; ++i)
+        data[i] = static_cast<uint8_t>(value >> (8 * i));
+}
+}
+
+/**
+ * @brief Constructor for GnssConfig.
+ * @param serial Reference to the GPS serial interface, already started by the board setup.
+ */
+GnssConfig::GnssConfig(HardwareSerial &serial) : mSerial(serial) {}
+
+/**
+ * @brief Finds the module and sets it to the fastest fix rate it sustains.
+ * @return True if a module answered and a rate was confirmed, false if the defaults were kept.
+ */
+bool GnssConfig::negotiate()
+{
+    uint32_t startBaud = mSerial.baudRate();
+    if (configureUblox())
+    {
+        mModule = "u-blox";
+        mUblox = true;
+    }
+    else if (configureCasic())
+    {
+        mModule = "CASIC";
+    }
+    else
+    {
+        mSerial.updateBaudRate(startBaud);
+        return false;
+    }
+    return negotiateRate();
+}
+
+/**
+ * @brief Sets up the port and output of a u-blox module, if the module acknowledges UBX.
+ * @return True if the module is a u-blox.
+ */
+bool GnssConfig::configureUblox()
+{
+    // Polling CFG-RATE is harmless and every u-blox acknowledges it.
+    if (!sendUbx(UbxParser::CLASS_CFG, UbxParser::CFG_RATE, nullptr, 0))
+        return false;
+
+    uint32_t startBaud = mSerial.baudRate();
+    if (startBaud < FAST_BAUD)
+    {
+        // The acknowledgement goes out at the old rate and is lost, so check with another poll.
+        setUbxPort(FAST_BAUD, UBX_PROTO_UBX | UBX_PROTO_NMEA, false);
+        mSerial.flush();
+        delay(SETTLE_MS);
+        mSerial.updateBaudRate(FAST_BAUD);
+        if (!sendUbx(UbxParser::CLASS_CFG, UbxParser::CFG_RATE, nullptr, 0))
+            mSerial.updateBaudRate(startBaud);
+    }
+
+    // Modules older than protocol 14 have no NAV-PVT and refuse it; they stay on NMEA.
+    const uint8_t navPvt[] = {UbxParser::CLASS_NAV, UbxParser::NAV_PVT, 1};
+    if (sendUbx(UbxParser::CLASS_CFG, UbxParser::CFG_MSG, navPvt, sizeof(navPvt)) &&
+        setUbxPort(mSerial.baudRate(), UBX_PROTO_UBX, true))
+    {
+        mProtocol = UBX;
+    }
+    else
+    {
+        for (uint8_t id : UBX_NMEA_EXTRA)
+        {
+            const uint8_t off[] = {UBX_CLASS_NMEA, id, 0};
+            sendUbx(UbxParser::CLASS_CFG, UbxParser::CFG_MSG, off, sizeof(off));
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Sets up the port and output of a CASIC module such as the L76K, if one is sending NMEA.
+ * @details CASIC commands are not acknowledged, so every step is checked by counting epochs.
+ * @return True if NMEA was heard.
+ */
+bool GnssConfig::configureCasic()
+{
+    mProtocol = NMEA;
+    uint32_t startBaud = mSerial.baudRate();
+    uint32_t found = 0;
+    const uint32_t bauds[] = {startBaud, CASIC_DEFAULT_BAUD};
+    for (uint32_t baud : bauds)
+    {
+        mSerial.updateBaudRate(baud);
+        if (countEpochs(MIN_MEASURE_MS + SETTLE_MS) > 0)
+        {
+            found = baud;
+            break;
+        }
+    }
+    if (!found)
+        return false;
+
+    // Only GGA and RMC, as beginGPS() asks for.
+    sendNmea("PCAS03,1,0,0,0,1,0,0,0,0,0,,,0,0");
+    if (found < FAST_BAUD)
+    {
+        sendNmea("PCAS01,5"); // 115200 baud
+        mSerial.flush();
+        delay(SETTLE_MS);
+        mSerial.updateBaudRate(FAST_BAUD);
+        if (countEpochs(MIN_MEASURE_MS + SETTLE_MS) == 0)
+            mSerial.updateBaudRate(found);
+    }
+    return true;
+}
+
+/**
+ * @brief Tries the intervals from the fastest down and keeps the first the module delivers.
+ * @return True if an interval was confirmed; otherwise the module is left at 1 s.
+ */
+bool GnssConfig::negotiateRate()
+{
+    for (uint32_t interval : INTERVALS_MS)
+    {
+        if (!linkCarries(interval) || !setRate(interval))
+            continue;
+
+        uint32_t window = std::max(static_cast<uint32_t>(MIN_MEASURE_MS), MEASURE_EPOCHS * interval);
+        uint32_t epochs = countEpochs(window);
+        if (epochs * interval * 100 >= window * RATE_TOLERANCE_PCT)
+        {
+            mIntervalMs = interval;
+            return true;
+        }
+    }
+    setRate(1000);
+    mIntervalMs = 1000;
+    return false;
+}
+
+/**
+ * @brief Asks the module for a navigation interval in its own command set.
+ * @param intervalMs Navigation interval.
+ * @return False if the module refused it.
+ */
+bool GnssConfig::setRate(uint32_t intervalMs)
+{
+    return mUblox ? setUbxRate(intervalMs) : setCasicRate(intervalMs);
+}
+
+/**
+ * @brief Sets the navigation interval of a u-blox module with UBX-CFG-RATE.
+ * @param intervalMs Navigation interval.
+ * @return True if the module acknowledged it.
+ */
+bool GnssConfig::setUbxRate(uint32_t intervalMs)
+{
+    uint8_t payload[6];
+    writeLe(&payload[0], intervalMs, 2); // measRate
+    writeLe(&payload[2], 1, 2);          // navRate, one solution per measurement
+    writeLe(&payload[4], 1, 2);          // timeRef, GPS time
+    return sendUbx(UbxParser::CLASS_CFG, UbxParser::CFG_RATE, payload, sizeof(payload));
+}
+
+/**
+ * @brief Sets the fix interval of a CASIC module with $PCAS02.
+ * @param intervalMs Fix interval.
+ * @return Always true; the module does not answer.
+ */
+bool GnssConfig::setCasicRate(uint32_t intervalMs)
+{
+    char body[16];
+    snprintf(body, sizeof(body), "PCAS02,%lu", static_cast<unsigned long>(intervalMs));
+    sendNmea(body);
+    return true;
+}
+
+/**
+ * @brief Sends a UBX frame and optionally waits for its acknowledgement.
+ * @param msgClass Class of the frame.
+ * @param msgId Id of the frame.
+ * @param payload Pointer to the payload, may be null if length is 0.
+ * @param length Length of the payload, at most UbxParser::MAX_PAYLOAD.
+ * @param waitAck Wait up to ACK_TIMEOUT_MS for ACK-ACK or ACK-NAK.
+ * @return True if the frame was acknowledged, or sent when not waiting.
+ */
+bool GnssConfig::sendUbx(uint8_t msgClass, uint8_t msgId, const uint8_t *payload, uint16_t length, bool waitAck)
+{
+    uint8_t frame[UbxParser::MAX_PAYLOAD + UbxParser::FRAME_OVERHEAD];
+    discardInput();
+    mSerial.write(frame, UbxParser::writeFrame(msgClass, msgId, payload, length, frame));
+    if (!waitAck)
+        return true;
+
+    UbxParser parser;
+    uint32_t start = millis();
+    while (millis() - start < ACK_TIMEOUT_MS)
+    {
+        while (mSerial.available())
+        {
+            if (!parser.feed(mSerial.read()) || parser.msgClass() != UbxParser::CLASS_ACK || parser.length() < 2)
+                continue;
+            if (parser.payload()[0] == msgClass && parser.payload()[1] == msgId)
+                return parser.msgId() == UbxParser::ACK_ACK;
+        }
+        delay(1);
+    }
+    return false;
+}
+
+/**
+ * @brief Configures the module's UART with UBX-CFG-PRT.
+ * @param baud UART rate.
+ * @param outProtocols Protocols the module sends, UBX_PROTO_* bits.
+ * @param waitAck Wait for the acknowledgement; pointless when the rate changes.
+ * @return True if acknowledged, or sent when not waiting.
+ */
+bool GnssConfig::setUbxPort(uint32_t baud, uint16_t outProtocols, bool waitAck)
+{
+    uint8_t payload[20] = {};
+    payload[0] = UBX_PORT_UART1;
+    writeLe(&payload[4], UBX_MODE_8N1, 4);
+    writeLe(&payload[8], baud, 4);
+    writeLe(&payload[12], UBX_PROTO_UBX | UBX_PROTO_NMEA, 2); // inProtoMask
+    writeLe(&payload[14], outProtocols, 2);
+    return sendUbx(UbxParser::CLASS_CFG, UbxParser::CFG_PRT, payload, sizeof(payload), waitAck);
+}
+
+/**
+ * @brief Sends an NMEA command, adding the framing and checksum.
+ * @param body Command between '$' and '*'.
+ */
+void GnssConfig::sendNmea(const char *body)
+{
+    uint8_t checksum = 0;
+    for (const char *c = body; *c; ++c)
+        checksum ^= static_cast<uint8_t>(*c);
+
+    char sentence[64];
+    int length = snprintf(sentence, sizeof(sentence), "$%s*%02X\r\n", body, checksum);
+    mSerial.write(reinterpret_cast<const uint8_t *>(sentence), std::min<size_t>(length, sizeof(sentence) - 1));
+    delay(50);
+}
+
+/**
+ * @brief Checks that the UART has room for an interval's output.
+ * @param intervalMs Navigation interval.
+ * @return True if an epoch's output fits in LINK_LOAD_PCT of the UART at this interval.
+ */
+bool GnssConfig::linkCarries(uint32_t intervalMs)
+{
+    size_t epochBytes = mProtocol == UBX ? UBX_EPOCH_BYTES : NMEA_EPOCH_BYTES;
+    // 10 bits per byte with start and stop bits.
+    return static_cast<uint64_t>(epochBytes) * 10 * 1000 * 100 <= static_cast<uint64_t>(mSerial.baudRate()) * intervalMs * LINK_LOAD_PCT;
+}
+
+/**
+ * @brief Counts the navigation epochs the module sends in a window.
+ * @details An epoch is a NAV-PVT frame in UBX, an RMC sentence in NMEA. Output
+ *          from before the window, possibly at an old rate, is discarded first.
+ * @param windowMs Length of the window.
+ * @return The number of epochs.
+ */
+uint32_t GnssConfig::countEpochs(uint32_t windowMs)
+{
+    delay(SETTLE_MS);
+    discardInput();
+
+    UbxParser parser;
+    char talker[5];
+    size_t talkerLength = sizeof(talker);
+    uint32_t epochs = 0;
+    uint32_t start = millis();
+    while (millis() - start < windowMs)
+    {
+        while (mSerial.available())
+        {
+            uint8_t c = mSerial.read();
+            if (mProtocol == UBX)
+            {
+                if (parser.feed(c) && parser.msgClass() == UbxParser::CLASS_NAV && parser.msgId() == UbxParser::NAV_PVT)
+                    epochs++;
+            }
+            else if (c == '$')
+            {
+                talkerLength = 0;
+            }
+            else if (talkerLength < sizeof(talker))
+            {
+                // "GPRMC", "GNRMC", ...: the sentence type follows the two-letter talker id.
+                talker[talkerLength++] = c;
+                if (talkerLength == sizeof(talker) && memcmp(&talker[2], "RMC", 3) == 0)
+                    epochs++;
+            }
+        }
+        delay(1);
+    }
+    return epochs;
+}
+
+/**
+ * @brief Drops whatever the module has sent so far.
+ */
+void GnssConfig::discardInput()
+{
+    while (mSerial.available())
+        mSerial.read();
+}
@@ -0,0 +1,280 @@
+/**
+ * @file GpsManager.cpp
+ * @brief Reads the GPS receiver in a background task and shares the latest fix without locks.
+ */
+
+#include "GpsManager.h"
+
+/**
+ * @brief Constructor for GpsManager.
+ * @param serial Reference to the GPS serial interface, already started by the board setup.
+ * @param clock Reference to the clock service to be disciplined by the GNSS time.
+ */
+GpsManager::GpsManager(HardwareSerial &serial, ClockService &clock) : mSerial(serial), mClock(clock), mConfig(serial)
+{
+    mNmea.setFastParse(true);
+}
+
+/**
+ * @brief Negotiates the module's rate and protocol, then starts the GPS task.
+ * @details The negotiation blocks for a second or more per rate tried.
+ * @return True if the task was created, false otherwise.
+ */
+bool GpsManager::begin()
+{
+    mClock.begin();
+    bool negotiated = mConfig.negotiate();
+    Serial.printf("GNSS: %s, %s at %lu ms%s\n", mConfig.moduleName(),
+                  mConfig.protocol() == GnssConfig::UBX ? "UBX NAV-PVT" : "NMEA",
+                  static_cast<unsigned long>(mConfig.intervalMs()), negotiated ? "" : " (not confirmed)");
+    mWindowStartMs = millis();
+
+    BaseType_t result = xTaskCreatePinnedToCore(
+        gpsTask,
+        "GpsTask",
+        TASK_STACK_SIZE,
+        this,
+        TASK_PRIORITY,
+        &mTaskHandle,
+        TASK_CORE);
+
+    if (result != pdPASS)
+    {
+        Serial.println("Failed to create GPS task!");
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief FreeRTOS task draining the GPS UART.
+ * @param param Pointer to the GpsManager instance.
+ */
+void GpsManager::gpsTask(void *param)
+{
+    GpsManager *manager = static_cast<GpsManager *>(param);
+    TickType_t wake = xTaskGetTickCount();
+    for (;;)
+    {
+        manager->drain();
+        vTaskDelayUntil(&wake, pdMS_TO_TICKS(POLL_MS));
+    }
+}
+
+/**
+ * @brief Feeds every waiting byte to the parser and publishes the fix when it changes.
+ * @details Only the GPS task writes mFix, so it may read it without the lock.
+ */
+void GpsManager::drain()
+{
+    Fix fix = mFix;
+    bool epoch = false;
+    bool changed = false;
+    if (mSerial.available())
+    {
+        uint32_t start = micros();
+        changed = mConfig.protocol() == GnssConfig::UBX ? drainUbx(fix, epoch) : drainNmea(fix, epoch);
+        mParseUs += micros() - start;
+    }
+    if (epoch)
+    {
+        fix.parseTime.add(mParseUs);
+        mParseUs = 0;
+        mWindowFixes++;
+    }
+
+    uint32_t now = millis();
+    if (now - mWindowStartMs >= FIX_RATE_WINDOW_MS)
+    {
+        fix.fixRateHz = mWindowFixes * 1000.0f / (now - mWindowStartMs);
+        mWindowStartMs = now;
+        mWindowFixes = 0;
+        changed = true;
+    }
+
+    if (changed)
+    {
+        publish(fix);
+    }
+}
+
+/**
+ * @brief Parses the waiting NMEA sentences into a fix.
+ * @param fix Reference to the fix to be updated.
+ * @param epoch Set if a new position fix was completed.
+ * @return True if the fix changed.
+ */
+bool GpsManager::drainNmea(Fix &fix, bool &epoch)
+{
+    bool changed = false;
+    while (mSerial.available())
+    {
+        if (!mNmea.encode(mSerial.read()))
+            continue;
+
+        if (mNmea.location.isUpdated())
+        {
+            // GGA and RMC both carry the position; count the fix once per time stamp.
+            if (mNmea.time.value() != mEpochTime)
+            {
+                mEpochTime = mNmea.time.value();
+                epoch = true;
+            }
+            // Only RMC carries the date, so only it can name the UTC second.
+            if (mNmea.date.isUpdated() && mNmea.date.isValid() && mNmea.time.isValid())
+            {
+                mClock.onGnssTime(ClockService::utcMicros(mNmea.date.year(), mNmea.date.month(), mNmea.date.day(),
+                                                          mNmea.time.hour(), mNmea.time.minute(), mNmea.time.second(),
+                                                          mNmea.time.centisecond() * 10000000L),
+                                  esp_timer_get_time());
+            }
+            // age() is the time since the sentence carrying the position was committed.
+            fix.latitudeE7 = toE7(mNmea.location.rawLat());
+            fix.longitudeE7 = toE7(mNmea.location.rawLng());
+            fix.fixMs = millis() - mNmea.location.age();
+            fix.valid = true;
+            changed = true;
+        }
+        if (mNmea.satellites.isUpdated())
+        {
+            fix.satellites = mNmea.satellites.value();
+            changed = true;
+        }
+        if (mNmea.hdop.isUpdated())
+        {
+            fix.hdopCenti = mNmea.hdop.value();
+            changed = true;
+        }
+        if (mNmea.speed.isUpdated())
+        {
+            // Hundredths of a knot; one knot is 1852 m per hour.
+            fix.speedCmS = static_cast<uint32_t>(mNmea.speed.value() * 1852LL / 3600);
+            fix.courseCdeg = mNmea.course.value();
+            changed = true;
+        }
+    }
+    changed |= mNmea.failedChecksum() != fix.checksumErrors;
+    fix.sentences = mNmea.passedChecksum();
+    fix.checksumErrors = mNmea.failedChecksum();
+    return changed;
+}
+
+/**
+ * @brief Parses the waiting UBX frames into a fix.
+ * @param fix Reference to the fix to be updated.
+ * @param epoch Set if a NAV-PVT with a position fix was completed.
+ * @return True if the fix changed.
+ */
+bool GpsManager::drainUbx(Fix &fix, bool &epoch)
+{
+    bool changed = false;
+    UbxParser::NavPvt pvt;
+    while (mSerial.available())
+    {
+        if (!mUbx.feed(mSerial.read()) || !mUbx.readNavPvt(pvt))
+            continue;
+
+        fix.satellites = pvt.numSv;
+        if (pvt.hasTime())
+        {
+            mClock.onGnssTime(ClockService::utcMicros(pvt.year, pvt.month, pvt.day, pvt.hour, pvt.minute, pvt.second, pvt.nanoNs),
+                              esp_timer_get_time());
+        }
+        if (pvt.hasFix())
+        {
+            fix.latitudeE7 = pvt.latE7;
+            fix.longitudeE7 = pvt.lonE7;
+            fix.speedCmS = pvt.gSpeedMmS > 0 ? pvt.gSpeedMmS / 10 : 0;
+            fix.courseCdeg = static_cast<uint32_t>(pvt.headMotE5 / 1000);
+            fix.fixMs = millis();
+            fix.valid = true;
+            epoch = true;
+        }
+        changed = true;
+    }
+    changed |= mUbx.checksumErrors() != fix.checksumErrors;
+    fix.sentences = mUbx.frameCount();
+    fix.checksumErrors = mUbx.checksumErrors();
+    return changed;
+}
+
+/**
+ * @brief Converts a TinyGPS++ coordinate to 1e-7 degrees without going through a double.
+ * @param raw Whole degrees and billionths of a degree, as parsed.
+ * @return Signed coordinate in 1e-7 degrees.
+ */
+int32_t GpsManager::toE7(const RawDegrees &raw)
+{
+    int32_t value = static_cast<int32_t>(raw.deg) * 10000000 + static_cast<int32_t>((raw.billionths + 50) / 100);
+    return raw.negative ? -value : value;
+}
+
+/**
+ * @brief Copies a fix into mFix under the sequence lock.
+ * @param fix Reference to the fix to be published.
+ */
+void GpsManager::publish(const Fix &fix)
+{
+    portENTER_CRITICAL(&mWriteMux);
+    uint32_t sequence = mSequence.load(std::memory_order_relaxed);
+    mSequence.store(sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    mFix = fix;
+    mSequence.store(sequence + 2, std::memory_order_release);
+    portEXIT_CRITICAL(&mWriteMux);
+}
+
+/**
+ * @brief Copies a consistent mFix.
+ * @details The writer holds the sequence odd for a few dozen cycles at most and
+ *          cannot be preempted meanwhile, so a reader on the other core spins
+ *          only briefly and one on the same core never does.
+ * @param fix Set to the latest fix.
+ */
+void GpsManager::snapshot(Fix &fix) const
+{
+    uint32_t before;
+    uint32_t after;
+    do
+    {
+        before = mSequence.load(std::memory_order_acquire);
+        fix = mFix;
+        std::atomic_thread_fence(std::memory_order_acquire);
+        after = mSequence.load(std::memory_order_relaxed);
+    } while ((before & 1) || before != after);
+}
+
+/**
+ * @brief Fills a Gps with the latest fix.
+ * @param gps Reference to the Gps structure to be filled.
+ */
+void GpsManager::read(Gps &gps) const
+{
+    Fix fix;
+    snapshot(fix);
+    gps.latitude_e7 = fix.latitudeE7;
+    gps.longitude_e7 = fix.longitudeE7;
+    gps.satellites = fix.satellites;
+    gps.hdop_centi = fix.hdopCenti;
+    gps.speed_cm_s = fix.speedCmS;
+    gps.course_cdeg = fix.courseCdeg;
+    gps.fix_age_ms = fix.valid ? millis() - fix.fixMs : NO_FIX_AGE;
+}
+
+/**
+ * @brief Fills the GPS counters of a Stats message.
+ * @param stats Reference to the Stats structure to be filled.
+ */
+void GpsManager::fillStats(Stats &stats) const
+{
+    Fix fix;
+    snapshot(fix);
+    stats.gps_sentences = fix.sentences;
+    stats.gps_checksum_errors = fix.checksumErrors;
+    stats.gps_fix_rate_hz = fix.fixRateHz;
+    stats.has_gps_parse_time = true;
+    fix.parseTime.fill(stats.gps_parse_time);
+    stats.gps_interval_ms = mConfig.intervalMs();
+    stats.gps_ubx = mConfig.protocol() == GnssConfig::UBX;
+    mClock.fillStats(stats);
+}
@@ -0,0 +1,353 @@
+/**
+ * @file LinkAdapter.cpp
+ * @brief Chooses the rung of the modulation ladder from receiver feedback and keeps both ends in step.
+ */
+
+#include "LinkAdapter.h"
+#include <algorithm>
+
+/**
+ * @brief Writes a control payload.
+ * @param frame Reference to the frame to be written.
+ * @param payload Pointer to a payload of at least FRAME_SIZE bytes.
+ * @return The payload length, FRAME_SIZE.
+ */
+size_t LinkAdapter::writeFrame(const Frame &frame, uint8_t *payload)
+{
+    payload[0] = LINK_MAGIC;
+    payload[1] = frame.type;
+    payload[2] = frame.rung;
+    payload[3] = frame.next;
+    memcpy(&payload[4], &frame.sequence, sizeof(frame.sequence));
+    memcpy(&payload[6], &frame.count, sizeof(frame.count));
+    payload[8] = static_cast<uint8_t>(frame.snrQuarterDb);
+    payload[9] = frame.rssiRaw;
+    return FRAME_SIZE;
+}
+
+/**
+ * @brief Reads a received payload as a control payload.
+ * @param payload Pointer to the payload.
+ * @param length Length of the payload.
+ * @param frame Set to the decoded frame.
+ * @return False if the payload is not a control payload.
+ */
+bool LinkAdapter::readFrame(const uint8_t *payload, size_t length, Frame &frame)
+{
+    if (length != FRAME_SIZE || payload[0] != LINK_MAGIC || (payload[1] != POLL && payload[1] != FEEDBACK))
+        return false;
+
+    frame.type = payload[1];
+    frame.rung = payload[2];
+    frame.next = payload[3];
+    memcpy(&frame.sequence, &payload[4], sizeof(frame.sequence));
+    memcpy(&frame.count, &payload[6], sizeof(frame.count));
+    frame.snrQuarterDb = static_cast<int8_t>(payload[8]);
+    frame.rssiRaw = payload[9];
+    return true;
+}
+
+/**
+ * @brief Looks up the lowest SNR the SX1262 demodulates at a spreading factor.
+ * @details From the datasheet: -2.5 dB per step from SF5 at -2.5 dB to SF12 at -20 dB.
+ * @param spreadingFactor LoRa spreading factor.
+ * @return The SNR floor in dB.
+ */
+float LinkAdapter::demodFloor(int32_t spreadingFactor)
+{
+    return -2.5f * (spreadingFactor - 4);
+}
+
+/**
+ * @brief Takes the ladder and thresholds from the settings and goes back to rung 0.
+ * @param settings Reference to the Settings.
+ */
+void LinkAdapter::configure(const Settings &settings)
+{
+    mLadderCount = std::min(static_cast<size_t>(settings.ladder_count), static_cast<size_t>(MAX_RUNGS));
+    memcpy(mLadder, settings.ladder, mLadderCount * sizeof(LinkRung));
+    mIntervalMs = settings.adapt_interval_ms;
+    mTargetPerPpm = settings.adapt_target_per_ppm;
+    mMarginDb = settings.adapt_margin_db;
+    mHysteresisDb = settings.adapt_hysteresis_db;
+    mRung = 0;
+    mNext = 0;
+    mSentTotal = 0;
+    mReceivedTotal = 0;
+}
+
+/**
+ * @brief Copies the modulation and power of a rung over the given settings.
+ * @param rung Index of the rung.
+ * @param config Reference to the Settings to be changed.
+ */
+void LinkAdapter::applyRung(uint8_t rung, Settings &config) const
+{
+    const LinkRung &step = mLadder[rung];
+    config.spreading_factor = step.spreading_factor;
+    config.bandwidth = step.bandwidth;
+    config.coding_rate = step.coding_rate;
+    config.power = step.power;
+}
+
+/**
+ * @brief Goes back to a rung after the radio refused the one just switched to.
+ * @details Nothing is proposed until the next feedback, so the refused rung is not retried at once.
+ * @param rung Index of the rung the radio is still on.
+ */
+void LinkAdapter::revertRung(uint8_t rung)
+{
+    mRung = rung;
+    mNext = rung;
+    mUpVotes = 0;
+}
+
+/**
+ * @brief Starts over on rung 0, e.g. when the state changes.
+ * @param nowMs millis() now.
+ * @param decision Set to the switch to rung 0, if there is one.
+ * @return True if the rung changed and the caller has to apply rung 0.
+ */
+bool LinkAdapter::restart(uint32_t nowMs, LinkAdapt &decision)
+{
+    mNext = 0;
+    mHaveBase = false;
+    mMissed = 0;
+    mUpVotes = 0;
+    mSnrSum = 0;
+    mRssiSum = 0;
+    mSignalCount = 0;
+    mHeardMs = nowMs;
+    if (mRung == 0)
+        return false;
+
+    fillDecision(0, AdaptReason_ADAPT_START, true, decision);
+    mRung = 0;
+    return true;
+}
+
+/**
+ * @brief Builds the next poll, carrying the proposed rung.
+ * @param poll Set to the poll to be sent.
+ */
+void LinkAdapter::makePoll(Frame &poll)
+{
+    mPollSent = mSentTotal;
+    poll = Frame();
+    poll.type = POLL;
+    poll.rung = mRung;
+    poll.next = mNext;
+    poll.sequence = ++mSequence;
+    poll.count = mPollSent;
+}
+
+/**
+ * @brief Acts on the receiver's answer to the latest poll.
+ * @details A feedback echoing a pending proposal completes the switch. Otherwise the
+ *          packet error rate and SNR margin since the previous answered poll decide the
+ *          next proposal: a step down as soon as either is out of bounds, a step up once
+ *          the next rung is predicted to keep the margin plus the hysteresis for UP_HOLD
+ *          feedbacks in a row.
+ * @param feedback Reference to the received feedback.
+ * @param decision Set to the switch or proposal made.
+ * @return True if a rung was switched to (decision.applied) or the proposal changed.
+ */
+bool LinkAdapter::onFeedback(const Frame &feedback, LinkAdapt &decision)
+{
+    mMissed = 0;
+
+    uint32_t sent = 0;
+    uint32_t received = 0;
+    if (mHaveBase)
+    {
+        sent = static_cast<uint16_t>(mPollSent - mBaseSent);
+        received = std::min(static_cast<uint32_t>(static_cast<uint16_t>(feedback.count - mBaseReceived)), sent);
+    }
+    mHaveBase = true;
+    mBaseSent = mPollSent;
+    mBaseReceived = feedback.count;
+
+    float snr = feedback.snrQuarterDb / 4.0f;
+    uint32_t perPpm = sent ? static_cast<uint32_t>(static_cast<uint64_t>(sent - received) * 1000000 / sent) : 0;
+    float margin = snr - demodFloor(mLadder[mRung].spreading_factor);
+
+    uint8_t next = mRung;
+    AdaptReason reason = mProposal;
+    bool applied = false;
+    if (mNext != mRung && feedback.next == mNext)
+    {
+        // The receiver switched after sending this; the figures are from the old rung.
+        next = mNext;
+        applied = true;
+        mUpVotes = 0;
+    }
+    else if (mRung > 0 && perPpm > mTargetPerPpm)
+    {
+        next = mRung - 1;
+        reason = AdaptReason_ADAPT_PER_HIGH;
+    }
+    else if (mRung > 0 && margin < mMarginDb)
+    {
+        next = mRung - 1;
+        reason = AdaptReason_ADAPT_MARGIN_LOW;
+    }
+    else if (mRung + 1u < mLadderCount && perPpm <= mTargetPerPpm && predictMargin(mRung + 1, snr) >= mMarginDb + mHysteresisDb)
+    {
+        if (++mUpVotes >= UP_HOLD)
+        {
+            next = mRung + 1;
+            reason = AdaptReason_ADAPT_MARGIN_HIGH;
+        }
+    }
+    else
+    {
+        mUpVotes = 0;
+    }
+
+    if (!applied && next == mNext)
+        return false;
+
+    fillDecision(next, reason, applied, decision);
+    decision.sent = sent;
+    decision.received = received;
+    decision.per_ppm = perPpm;
+    decision.snr = snr;
+    decision.margin_db = margin;
+
+    if (applied)
+    {
+        mRung = next;
+    }
+    else
+    {
+        mNext = next;
+        mProposal = reason;
+        mUpVotes = 0;
+    }
+    return true;
+}
+
+/**
+ * @brief Counts a poll that got no answer and falls back to rung 0 after MAX_MISSED_POLLS.
+ * @param decision Set to the switch to rung 0, if there is one.
+ * @return True if the rung changed and the caller has to apply rung 0.
+ */
+bool LinkAdapter::onMissedFeedback(LinkAdapt &decision)
+{
+    mUpVotes = 0;
+    if (++mMissed < MAX_MISSED_POLLS || (mRung == 0 && mNext == 0))
+        return false;
+
+    fillDecision(0, AdaptReason_ADAPT_NO_FEEDBACK, true, decision);
+    mRung = 0;
+    mNext = 0;
+    mHaveBase = false;
+    return true;
+}
+
+/**
+ * @brief Accounts for a packet received without errors.
+ * @param payload Pointer to the payload.
+ * @param length Length of the payload.
+ * @param snr SNR of the packet in dB.
+ * @param rssi RSSI of the packet in dBm.
+ * @param nowMs millis() now.
+ * @param poll Set to the poll, if the packet is one.
+ * @return True if the packet is a poll to be answered rather than logged.
+ */
+bool LinkAdapter::receive(const uint8_t *payload, size_t length, float snr, float rssi, uint32_t nowMs, Frame &poll)
+{
+    mHeardMs = nowMs;
+    mSnrSum += snr;
+    mRssiSum += rssi;
+    mSignalCount++;
+
+    if (readFrame(payload, length, poll) && poll.type == POLL)
+        return true;
+
+    mReceivedTotal++;
+    return false;
+}
+
+/**
+ * @brief Builds the feedback for a poll and takes up the rung it proposes.
+ * @details The caller switches to decision.rung once the feedback has been sent.
+ * @param poll Reference to the received poll.
+ * @param feedback Set to the feedback to be sent.
+ * @param decision Set to the switch, if there is one.
+ * @return True if the rung changes once the feedback is out.
+ */
+bool LinkAdapter::answer(const Frame &poll, Frame &feedback, LinkAdapt &decision)
+{
+    float snr = mSignalCount ? mSnrSum / mSignalCount : 0;
+    float rssi = mSignalCount ? mRssiSum / mSignalCount : 0;
+    feedback = Frame();
+    feedback.type = FEEDBACK;
+    feedback.rung = mRung;
+    feedback.next = poll.next;
+    feedback.sequence = poll.sequence;
+    feedback.count = mReceivedTotal;
+    feedback.snrQuarterDb = static_cast<int8_t>(std::max(-128.0f, std::min(127.0f, snr * 4)));
+    feedback.rssiRaw = static_cast<uint8_t>(std::max(0.0f, std::min(255.0f, -2 * rssi)));
+    mSnrSum = 0;
+    mRssiSum = 0;
+    mSignalCount = 0;
+
+    if (poll.next == mRung || poll.next >= mLadderCount)
+        return false;
+
+    fillDecision(poll.next, AdaptReason_ADAPT_PEER, true, decision);
+    decision.snr = snr;
+    mRung = poll.next;
+    return true;
+}
+
+/**
+ * @brief Falls back to rung 0 when nothing has been heard for LOST_POLLS poll intervals.
+ * @param nowMs millis() now.
+ * @param decision Set to the switch to rung 0, if there is one.
+ * @return True if the rung changed and the caller has to apply rung 0.
+ */
+bool LinkAdapter::checkLost(uint32_t nowMs, LinkAdapt &decision)
+{
+    if (mRung == 0 || nowMs - mHeardMs < LOST_POLLS * mIntervalMs)
+        return false;
+
+    fillDecision(0, AdaptReason_ADAPT_LINK_LOST, true, decision);
+    mRung = 0;
+    mHeardMs = nowMs;
+    return true;
+}
+
+/**
+ * @brief Fills the parts of a decision every caller needs.
+ * @param rung Rung switched to or proposed.
+ * @param reason Why.
+ * @param applied True for a switch, false for a proposal.
+ * @param decision Reference to the LinkAdapt to be filled.
+ */
+void LinkAdapter::fillDecision(uint8_t rung, AdaptReason reason, bool applied, LinkAdapt &decision) const
+{
+    decision = LinkAdapt_init_zero;
+    decision.rung = rung;
+    decision.previous_rung = mRung;
+    decision.reason = reason;
+    decision.applied = applied;
+    decision.has_settings = true;
+    decision.settings = mLadder[rung];
+}
+
+/**
+ * @brief Predicts the SNR margin another rung would have, from the SNR on the current one.
+ * @details Narrower bandwidth lets in less noise and more power adds signal, both dB for dB.
+ * @param rung Index of the other rung.
+ * @param snr SNR measured on the current rung in dB.
+ * @return The predicted margin over the other rung's demodulation floor in dB.
+ */
+float LinkAdapter::predictMargin(uint8_t rung, float snr) const
+{
+    const LinkRung &from = mLadder[mRung];
+    const LinkRung &to = mLadder[rung];
+    float predicted = snr + 10 * log10f(from.bandwidth / to.bandwidth) + (to.power - from.power);
+    return predicted - demodFloor(to.spreading_factor);
+}
@@ -0,0 +1,131 @@
+/**
+ * @file LinkManager.cpp
+ * @brief Negotiates the host serial baud rate and answers link self-tests.
+ */
+
+#include "LinkManager.h"
+
+/**
+ * @brief Constructor for LinkManager.
+ * @param serialMgr Reference to the SerialTaskManager receiving host frames.
+ * @param serialTx Reference to the SerialTxManager used for host output.
+ */
+LinkManager::LinkManager(SerialTaskManager &serialMgr, SerialTxManager &serialTx)
+    : mSerialMgr(serialMgr), mSerialTx(serialTx) {}
+
+/**
+ * @brief Checks whether a baud rate may be requested by the host.
+ * @param baudRate The requested baud rate.
+ * @return True if the rate is supported.
+ */
+bool LinkManager::isSupportedBaudRate(uint32_t baudRate)
+{
+    switch (baudRate)
+    {
+    case 115200:
+    case 230400:
+    case 460800:
+    case 921600:
+    case 1500000:
+    case 2000000:
+        return true;
+    default:
+        return false;
+    }
+}
+
+/**
+ * @brief Switches to a new baud rate provisionally, pending a commit from the host.
+ * @details Asking for the fallback rate while a change is pending abandons the change.
+ *          The caller must acknowledge the request before calling this so the
+ *          acknowledgement still goes out at the old rate.
+ * @param baudRate The new baud rate.
+ */
+void LinkManager::changeBaudRate(uint32_t baudRate)
+{
+    if (mPending && baudRate == mFallbackBaud)
+    {
+        mPending = false;
+        apply(baudRate);
+        return;
+    }
+
+    if (!mPending)
+    {
+        mFallbackBaud = mBaudRate;
+    }
+    mPending = true;
+    mDeadlineMs = millis() + COMMIT_TIMEOUT_MS;
+    apply(baudRate);
+}
+
+/**
+ * @brief Makes the current baud rate permanent until the next request or reset.
+ */
+void LinkManager::commitBaudRate()
+{
+    mPending = false;
+}
+
+/**
+ * @brief Falls back to the previous baud rate if an uncommitted change timed out or is failing.
+ */
+void LinkManager::poll()
+{
+    if (!mPending)
+        return;
+
+    bool expired = static_cast<int32_t>(millis() - mDeadlineMs) >= 0;
+    bool failing = mSerialMgr.errorCount() - mErrorBase > MAX_TEST_ERRORS;
+    if (expired || failing)
+    {
+        mPending = false;
+        apply(mFallbackBaud);
+    }
+}
+
+/**
+ * @brief Echoes a LINK_TEST packet back to the host with the device's receive statistics.
+ * @param test Reference to the received LinkTest.
+ * @param frameLength Length of the received frame.
+ * @param rxTimeUs micros() when the frame was completed.
+ */
+void LinkManager::echo(const LinkTest &test, size_t frameLength, uint32_t rxTimeUs)
+{
+    if (mTestFrames++ == 0)
+    {
+        mFirstTestUs = rxTimeUs;
+    }
+    else
+    {
+        mTestBytes += frameLength;
+    }
+    mLastTestUs = rxTimeUs;
+
+    Packet &packet = mSerialTx.reply();
+    packet.type = PacketType_LINK_TEST;
+    packet.has_link_test = true;
+    packet.link_test = test;
+    packet.link_test.rx_frames = mTestFrames;
+    packet.link_test.rx_errors = mSerialMgr.errorCount() - mErrorBase;
+
+    uint32_t elapsedUs = mLastTestUs - mFirstTestUs;
+    packet.link_test.rx_bytes_per_s = elapsedUs ? static_cast<uint32_t>(mTestBytes * 1000000ULL / elapsedUs) : 0;
+
+    mSerialTx.sendPacket(packet);
+}
+
+/**
+ * @brief Queues the switch to a baud rate and restarts the link test counters.
+ * @param baudRate The new baud rate.
+ */
+void LinkManager::apply(uint32_t baudRate)
+{
+    if (!mSerialTx.changeBaudRate(baudRate))
+        return;
+
+    mBaudRate = baudRate;
+    mErrorBase = mSerialMgr.errorCount();
+    mTestFrames = 0;
+    mTestBytes = 0;
+}
@@ -0,0 +1,234 @@
+/**
+ * @file ProbeTracker.cpp
+ * @brief Computes loss, reordering and latency of sequence-numbered probe packets on the receiver.
+ */
+
+#include "ProbeTracker.h"
+#include <algorithm>
+
+/**
+ * @brief Writes the probe header at the start of a payload.
+ * @param payload Pointer to a payload of at least HEADER_SIZE bytes.
+ * @param sequence Sequence number of the probe.
+ * @param sentUs esp_timer_get_time() when the probe is sent.
+ */
+void ProbeTracker::writeHeader(uint8_t *payload, uint32_t sequence, uint64_t sentUs)
+{
+    payload[0] = PROBE_MAGIC;
+    memcpy(&payload[1], &sequence, sizeof(sequence));
+    memcpy(&payload[5], &sentUs, sizeof(sentUs));
+}
+
+/**
+ * @brief Reads the probe header of a received payload.
+ * @param payload Pointer to the payload.
+ * @param length Length of the payload.
+ * @param sequence Set to the sequence number of the probe.
+ * @param sentUs Set to the transmitter's esp_timer_get_time() when the probe was sent.
+ * @return False if the payload is not a probe.
+ */
+bool ProbeTracker::readHeader(const uint8_t *payload, size_t length, uint32_t &sequence, uint64_t &sentUs)
+{
+    if (length < HEADER_SIZE || payload[0] != PROBE_MAGIC)
+        return false;
+
+    memcpy(&sequence, &payload[1], sizeof(sequence));
+    memcpy(&sentUs, &payload[5], sizeof(sentUs));
+    return true;
+}
+
+/**
+ * @brief Sets the report window and starts a new test.
+ * @param window Expected packets per report, 0 to disable the test.
+ */
+void ProbeTracker::configure(uint32_t window)
+{
+    mWindow = std::min(window, static_cast<uint32_t>(MAX_WINDOW));
+    reset();
+}
+
+/**
+ * @brief Forgets everything received so far; the next probe starts a new test.
+ */
+void ProbeTracker::reset()
+{
+    mStarted = false;
+    mReports = 0;
+    mTotalReceived = 0;
+    mTotalLost = 0;
+    startWindow();
+}
+
+/**
+ * @brief Accounts for one received packet.
+ * @details A packet with a bad CRC is only counted, since its sequence number cannot be
+ *          trusted; packets that are not probes are ignored. A gap in the sequence is
+ *          counted as lost until the missing probes turn up, which then count as reordered.
+ *          A sequence number further back than the history, or one that goes back while
+ *          its send stamp goes forward, means the transmitter started a new schedule; the
+ *          sequence restarts there and the window keeps the probes it already expected.
+ * @param log Reference to the reception log of the packet.
+ * @return True once the window is complete and fillReport() should be called.
+ */
+bool ProbeTracker::add(const Log &log)
+{
+    if (log.crc_error || log.general_error)
+    {
+        mCrcErrors++;
+        return false;
+    }
+
+    uint32_t sequence;
+    uint64_t sentUs;
+    if (!readHeader(log.payload.bytes, log.payload.size, sequence, sentUs))
+        return false;
+
+    int64_t latencyUs = static_cast<int64_t>(log.rx_done_us) - static_cast<int64_t>(sentUs);
+    if (!mStarted)
+    {
+        mStarted = true;
+        mNextSeq = sequence;
+        mWindowStart = sequence;
+        mSeen = 0;
+        mNewestSentUs = sentUs;
+        mOffsetUs = latencyUs;
+    }
+
+    int32_t ahead = static_cast<int32_t>(sequence - mNextSeq);
+    if (ahead >= 0)
+    {
+        if (ahead > 0)
+        {
+            mLost += ahead;
+            mTotalLost += ahead;
+            noteBurst(ahead);
+        }
+        uint32_t shift = ahead + 1;
+        mSeen = (shift >= 64 ? 0 : mSeen << shift) | 1;
+        mNextSeq = sequence + 1;
+        mNewestSentUs = sentUs;
+    }
+    else if (static_cast<uint32_t>(-ahead) > 64 || sentUs > mNewestSentUs)
+    {
+        // Too far back to be late, or sent after the newest probe: a new schedule numbering from 0.
+        mWindowStart = sequence - (mNextSeq - mWindowStart);
+        mSeen = 1;
+        mNextSeq = sequence + 1;
+        mNewestSentUs = sentUs;
+    }
+    else
+    {
+        uint32_t behind = -ahead - 1;
+        if ((mSeen >> behind) & 1)
+        {
+            mDuplicates++;
+            return false;
+        }
+        mSeen |= 1ULL << behind;
+        mReordered++;
+        if (mLost > 0)
+            mLost--;
+        if (mTotalLost > 0)
+            mTotalLost--;
+    }
+
+    mReceived++;
+    mTotalReceived++;
+    mOffsetUs = std::min(mOffsetUs, latencyUs);
+    if (mLatencyCount < MAX_WINDOW)
+    {
+        mLatencyUs[mLatencyCount++] = latencyUs;
+    }
+
+    return mNextSeq - mWindowStart >= mWindow;
+}
+
+/**
+ * @brief Checks whether the current window holds anything worth reporting.
+ * @return True if a packet was accounted for since the last report.
+ */
+bool ProbeTracker::hasPending() const
+{
+    return mReceived > 0 || mLost > 0 || mDuplicates > 0 || mCrcErrors > 0;
+}
+
+/**
+ * @brief Reports the current window and starts the next one.
+ * @details Latency percentiles are nearest-rank over the window, relative to clock_offset_us.
+ * @param report Reference to the ProbeReport to be filled.
+ */
+void ProbeTracker::fillReport(ProbeReport &report)
+{
+    report = ProbeReport_init_zero;
+    report.window = mReports++;
+    report.expected = mNextSeq - mWindowStart;
+    report.received = mReceived;
+    report.lost = mLost;
+    report.duplicates = mDuplicates;
+    report.reordered = mReordered;
+    report.crc_errors = mCrcErrors;
+    report.per_ppm = report.expected ? static_cast<uint32_t>(static_cast<uint64_t>(mLost) * 1000000 / report.expected) : 0;
+    report.clock_offset_us = mOffsetUs;
+    report.bursts = mBursts;
+    report.burst_max = mBurstMax;
+    report.burst_hist_count = BURST_BUCKETS;
+    memcpy(report.burst_hist, mBurstHist, sizeof(mBurstHist));
+    report.total_received = mTotalReceived;
+    report.total_lost = mTotalLost;
+
+    if (mLatencyCount > 0)
+    {
+        std::sort(mLatencyUs, mLatencyUs + mLatencyCount);
+        report.latency_p50_us = latencyPercentile(50);
+        report.latency_p90_us = latencyPercentile(90);
+        report.latency_p99_us = latencyPercentile(99);
+        report.latency_max_us = latencyPercentile(100);
+    }
+
+    startWindow();
+}
+
+/**
+ * @brief Looks up a nearest-rank latency percentile of the window; mLatencyUs must be sorted.
+ * @param percent Percentile, 1 to 100.
+ * @return The latency relative to the fastest packet of the test, in microseconds.
+ */
+uint32_t ProbeTracker::latencyPercentile(uint32_t percent) const
+{
+    size_t rank = (mLatencyCount * percent + 99) / 100;
+    return static_cast<uint32_t>(mLatencyUs[rank > 0 ? rank - 1 : 0] - mOffsetUs);
+}
+
+/**
+ * @brief Clears the per-window counters; the window starts at the next expected sequence number.
+ */
+void ProbeTracker::startWindow()
+{
+    mWindowStart = mNextSeq;
+    mReceived = 0;
+    mLost = 0;
+    mDuplicates = 0;
+    mReordered = 0;
+    mCrcErrors = 0;
+    mBursts = 0;
+    mBurstMax = 0;
+    memset(mBurstHist, 0, sizeof(mBurstHist));
+    mLatencyCount = 0;
+}
+
+/**
+ * @brief Records a run of consecutive missing probes.
+ * @param length Number of probes in the run.
+ */
+void ProbeTracker::noteBurst(uint32_t length)
+{
+    mBursts++;
+    mBurstMax = std::max(mBurstMax, length);
+
+    size_t bucket = 0;
+    while (bucket + 1 < BURST_BUCKETS && length > (1u << bucket))
+    {
+        bucket++;
+    }
+    mBurstHist[bucket]++;
+}
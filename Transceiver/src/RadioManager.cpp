@@ -11,10 +11,12 @@ RadioManager *RadioManager::instance = nullptr;
 /**
  * @brief Constructor for RadioManager.
  * @param mRadio Reference to the SX1262 radio module.
- * @param gpsSerial Reference to the GPS serial interface.
+ * @param gps Reference to the GpsManager.
+ * @param clock Reference to the ClockService that converts log stamps to UTC.
+ * @param serialTx Reference to the SerialTxManager used for host output.
  */
-RadioManager::RadioManager(SX1262 &radio, HardwareSerial &gpsSerial)
-    : mRadio(radio), gpsSerial(gpsSerial), transmittedFlag(false), receivedFlag(false)
+RadioManager::RadioManager(SX1262Burst &radio, GpsManager &gps, ClockService &clock, SerialTxManager &serialTx)
+    : mRadio(radio), mGps(gps), mClock(clock), mSerialTx(serialTx), transmittedFlag(false), receivedFlag(false)
 {
     instance = this;
 }
@@ -26,6 +28,29 @@ RadioManager::RadioManager(SX1262 &radio, HardwareSerial &gpsSerial)
  */
 bool RadioManager::initialize(SettingsManager &settings)
 {
+    mLock = xSemaphoreCreateMutex();
+    mLogLock = xSemaphoreCreateMutex();
+    mCaptureFree = xQueueCreate(CAPTURE_SLOTS, sizeof(uint8_t));
+    mCaptureReady = xQueueCreate(CAPTURE_SLOTS, sizeof(uint8_t));
+    if (!mLock || !mLogLock || !mCaptureFree || !mCaptureReady)
+    {
+        return false;
+    }
+    for (uint8_t slot = 0; slot < CAPTURE_SLOTS; ++slot)
+    {
+        xQueueSend(mCaptureFree, &slot, 0);
+    }
+
+    esp_timer_create_args_t timerArgs = {};
+    timerArgs.callback = rssiTimerCallback;
+    timerArgs.arg = this;
+    timerArgs.dispatch_method = ESP_TIMER_TASK;
+    timerArgs.name = "rssi";
+    if (esp_timer_create(&timerArgs, &mRssiTimer) != ESP_OK)
+    {
+        return false;
+    }
+
     int state = mRadio.begin();
     if (state != RADIOLIB_ERR_NONE)
     {
@@ -36,6 +61,38 @@ bool RadioManager::initialize(SettingsManager &settings)
     // Since I don't send an initial message at startup, transmitted must be set true at init
     transmittedFlag = true;
 
+#ifndef RADIO_RX_IN_LOOP
+    BaseType_t result = xTaskCreatePinnedToCore(
+        radioTask,
+        "RadioTask",
+        TASK_STACK_SIZE,
+        this,
+        TASK_PRIORITY,
+        &mTaskHandle,
+        TASK_CORE);
+
+    if (result != pdPASS)
+    {
+        Serial.println("Failed to create radio task!");
+        return false;
+    }
+
+    result = xTaskCreatePinnedToCore(
+        logTask,
+        "LogTask",
+        LOG_TASK_STACK_SIZE,
+        this,
+        LOG_TASK_PRIORITY,
+        &mLogTaskHandle,
+        LOG_TASK_CORE);
+
+    if (result != pdPASS)
+    {
+        Serial.println("Failed to create log task!");
+        return false;
+    }
+#endif
+
     return true;
 }
 
@@ -46,57 +103,225 @@ bool RadioManager::initialize(SettingsManager &settings)
  */
 bool RadioManager::configure(const SettingsManager &settings)
 {
+    xSemaphoreTake(mLock, portMAX_DELAY);
+    xSemaphoreTake(mLogLock, portMAX_DELAY);
+    bool ok = applySettings(settings);
+    xSemaphoreGive(mLogLock);
+    xSemaphoreGive(mLock);
+    return ok;
+}
 
-    if (mRadio.setFrequency(settings.mConfig.frequency) == RADIOLIB_ERR_INVALID_FREQUENCY)
+/**
+ * @brief Applies the given settings to the radio module; the caller holds mLock and mLogLock.
+ * @param settings Reference to the SettingsManager.
+ * @return True if configuration is successful, false otherwise.
+ */
+bool RadioManager::applySettings(const SettingsManager &settings)
+{
+    // With adaptation on, the modulation and power come from rung 0 of the ladder.
+    Settings config = settings.mConfig;
+    abortPoll();
+    mAdapter.configure(config);
+
+    int64_t startUs = esp_timer_get_time();
+    bool changed = false;
+    bool ok = true;
+    if (mAdapter.enabled())
+    {
+        // Every rung is tried on the radio, so a ladder it cannot take is refused here
+        // rather than when the link steps onto the bad rung. Rung 0 goes last and stays.
+        for (size_t rung = mAdapter.rungCount(); ok && rung-- > 0;)
+        {
+            mAdapter.applyRung(rung, config);
+            bool rungChanged = false;
+            ok = applyRadioSettings(config, rungChanged) && mApplied.coding_rate == config.coding_rate;
+            changed = changed || rungChanged;
+            if (!ok)
+            {
+                Serial.printf("Error: Rung %u of the ladder is invalid for this module!\n", static_cast<unsigned>(rung));
+            }
+        }
+    }
+    else
+    {
+        ok = applyRadioSettings(config, changed);
+    }
+    if (changed)
+    {
+        mReconfigureTime.add(static_cast<uint32_t>(esp_timer_get_time() - startUs));
+    }
+    if (!ok)
     {
-        Serial.println("Error: Selected frequency is invalid for this module!");
         return false;
     }
 
-    if (mRadio.setOutputPower(settings.mConfig.power) == RADIOLIB_ERR_INVALID_OUTPUT_POWER)
+    // Send out anything batched under the old limits before applying the new ones.
+    flushLogBatch();
+    mBatchSize = std::min(settings.mConfig.batch_size, static_cast<uint32_t>(MAX_BATCH_LOGS));
+    mBatchTimeoutMs = settings.mConfig.batch_timeout_ms;
+    mTxOverflow = settings.mConfig.tx_overflow;
+    mTxBurst = settings.mConfig.tx_burst;
+    mRadio.setPacketConfig(settings.mConfig.preamble, settings.mConfig.set_crc);
+    if (changed)
     {
-        Serial.println("Error: Selected output power is invalid for this module!");
-        return false;
+        mTxGap.reset(); // gaps depend on the modulation, so only compare like with like
+        unstagePreloaded();
     }
 
-    if (mRadio.setBandwidth(settings.mConfig.bandwidth) == RADIOLIB_ERR_INVALID_BANDWIDTH)
+    mRssiPeriodConfigUs = settings.mConfig.rssi_period_us;
+    updateRssiPeriod();
+    mRssiEncoding = settings.mConfig.rssi_encoding;
+    mProbe.configure(settings.mConfig.probe_window);
+
+    // Frames packed under the old size go out as they are, if the queue has room for them.
+    flushAggregate(true);
+    mTxDroppedNewest += mAggregateFrames;
+    mAggregate.size = 0;
+    mAggregateFrames = 0;
+    mAggregateBytes = std::min(settings.mConfig.aggregate_bytes, static_cast<uint32_t>(sizeof(mAggregate.bytes)));
+    mAggregateTimeoutMs = settings.mConfig.aggregate_timeout_ms;
+
+    if (mAdapter.enabled())
     {
-        Serial.println("Error: Selected bandwidth is invalid for this module!");
-        return false;
+        LinkAdapt decision = LinkAdapt_init_zero;
+        decision.reason = AdaptReason_ADAPT_START;
+        decision.applied = true;
+        decision.has_settings = true;
+        decision.settings = settings.mConfig.ladder[0];
+        queueAdaptEvent(decision);
     }
 
-    if (mRadio.setSpreadingFactor(settings.mConfig.spreading_factor) == RADIOLIB_ERR_INVALID_SPREADING_FACTOR)
+    return true;
+}
+
+/**
+ * @brief Sets the RSSI sample period for the modulation in use.
+ * @details By default sample once per symbol: 2^SF chips at BW chips per second.
+ */
+void RadioManager::updateRssiPeriod()
+{
+    uint32_t symbolUs = static_cast<uint32_t>((1UL << mApplied.spreading_factor) * 1000.0f / mApplied.bandwidth);
+    mRssiPeriodUs = std::max(mRssiPeriodConfigUs ? mRssiPeriodConfigUs : symbolUs, static_cast<uint32_t>(MIN_RSSI_PERIOD_US));
+}
+
+/**
+ * @brief Issues the radio commands for the parameters that differ from those last applied.
+ * @details Every command is sent on the first call. mApplied follows each command
+ *          that succeeds, so reverting after a failure only touches what was changed.
+ *          Retuning within the same image calibration band skips the calibration.
+ * @param config Reference to the Settings to apply.
+ * @param changed Set to true if any radio command was sent.
+ * @return True if configuration is successful, false otherwise.
+ */
+bool RadioManager::applyRadioSettings(const Settings &config, bool &changed)
+{
+    bool all = !mRadioConfigured;
+    changed = false;
+
+    if (all || config.frequency != mApplied.frequency)
     {
-        Serial.println("Error: Selected spreading factor is invalid for this module!");
-        return false;
+        changed = true;
+        bool calibrated = false;
+        if (mRadio.tune(config.frequency, calibrated) == RADIOLIB_ERR_INVALID_FREQUENCY)
+        {
+            Serial.println("Error: Selected frequency is invalid for this module!");
+            return false;
+        }
+        mApplied.frequency = config.frequency;
+        if (calibrated)
+        {
+            mImageCalibrations++;
+        }
+    }
+
+    if (all || config.power != mApplied.power)
+    {
+        changed = true;
+        if (mRadio.setOutputPower(config.power) == RADIOLIB_ERR_INVALID_OUTPUT_POWER)
+        {
+            Serial.println("Error: Selected output power is invalid for this module!");
+            return false;
+        }
+        mApplied.power = config.power;
     }
 
-    if (mRadio.setCodingRate(settings.mConfig.coding_rate) == RADIOLIB_ERR_INVALID_CODING_RATE)
+    if (all || config.bandwidth != mApplied.bandwidth)
     {
-        Serial.println("Error: Selected coding rate is invalid for this module!");
+        changed = true;
+        if (mRadio.setBandwidth(config.bandwidth) == RADIOLIB_ERR_INVALID_BANDWIDTH)
+        {
+            Serial.println("Error: Selected bandwidth is invalid for this module!");
+            return false;
+        }
+        mApplied.bandwidth = config.bandwidth;
     }
 
-    if (mRadio.setPreambleLength(settings.mConfig.preamble) == RADIOLIB_ERR_INVALID_PREAMBLE_LENGTH)
+    if (all || config.spreading_factor != mApplied.spreading_factor)
     {
-        Serial.println("Error: Selected preamble length is invalid for this module!");
-        return false;
+        changed = true;
+        if (mRadio.setSpreadingFactor(config.spreading_factor) == RADIOLIB_ERR_INVALID_SPREADING_FACTOR)
+        {
+            Serial.println("Error: Selected spreading factor is invalid for this module!");
+            return false;
+        }
+        mApplied.spreading_factor = config.spreading_factor;
     }
 
-    if (mRadio.setCRC(settings.mConfig.set_crc) == RADIOLIB_ERR_INVALID_CRC_CONFIGURATION)
+    if (all || config.coding_rate != mApplied.coding_rate)
     {
-        Serial.println("Error: Selected CRC is invalid for this module!");
-        return false;
+        changed = true;
+        if (mRadio.setCodingRate(config.coding_rate) == RADIOLIB_ERR_INVALID_CODING_RATE)
+        {
+            Serial.println("Error: Selected coding rate is invalid for this module!");
+        }
+        else
+        {
+            mApplied.coding_rate = config.coding_rate;
+        }
     }
 
-    if (mRadio.setSyncWord(settings.mConfig.sync_word) != RADIOLIB_ERR_NONE)
+    if (all || config.preamble != mApplied.preamble)
     {
-        Serial.println("Error: Unable to set sync word!");
-        return false;
+        changed = true;
+        if (mRadio.setPreambleLength(config.preamble) == RADIOLIB_ERR_INVALID_PREAMBLE_LENGTH)
+        {
+            Serial.println("Error: Selected preamble length is invalid for this module!");
+            return false;
+        }
+        mApplied.preamble = config.preamble;
     }
-    if (mRadio.setCurrentLimit(140) == RADIOLIB_ERR_INVALID_CURRENT_LIMIT)
+
+    if (all || config.set_crc != mApplied.set_crc)
     {
-        Serial.println(F("Selected current limit is invalid for this module!"));
-        return false;
+        changed = true;
+        if (mRadio.setCRC(config.set_crc) == RADIOLIB_ERR_INVALID_CRC_CONFIGURATION)
+        {
+            Serial.println("Error: Selected CRC is invalid for this module!");
+            return false;
+        }
+        mApplied.set_crc = config.set_crc;
+    }
+
+    if (all || config.sync_word != mApplied.sync_word)
+    {
+        changed = true;
+        if (mRadio.setSyncWord(config.sync_word) != RADIOLIB_ERR_NONE)
+        {
+            Serial.println("Error: Unable to set sync word!");
+            return false;
+        }
+        mApplied.sync_word = config.sync_word;
+    }
+
+    // The current limit is not a setting, so it only needs setting once.
+    if (all)
+    {
+        if (mRadio.setCurrentLimit(140) == RADIOLIB_ERR_INVALID_CURRENT_LIMIT)
+        {
+            Serial.println(F("Selected current limit is invalid for this module!"));
+            return false;
+        }
+        mRadioConfigured = true;
     }
 
     return true;
@@ -104,6 +329,8 @@ bool RadioManager::configure(const SettingsManager &settings)
 
 /**
  * @brief Transmits data using the radio module.
+ * @details Does nothing unless the previous transmission has finished; use
+ *          queueTransmission() to have the payload sent once it has.
  * @param data Pointer to the data to be transmitted.
  * @param length Length of the data to be transmitted.
  */
@@ -118,6 +345,309 @@ void RadioManager::transmit(const uint8_t *data, size_t length)
     }
 }
 
+/**
+ * @brief Queues a payload to be transmitted once the radio is free.
+ * @details A full queue is handled according to the tx_overflow setting, and
+ *          every payload that is not sent is counted in the transmit logs. With
+ *          aggregation enabled the payload is packed together with the ones
+ *          around it instead of being sent on its own.
+ * @param data Pointer to the data to be transmitted.
+ * @param length Length of the data to be transmitted.
+ * @param evicted Set to the number of older payloads discarded to make room.
+ * @return True if the payload was queued.
+ */
+bool RadioManager::queueTransmission(const uint8_t *data, size_t length, uint32_t &evicted)
+{
+    evicted = 0;
+    if (mAggregateBytes > 0)
+        return packFrame(data, length, evicted);
+    return enqueuePayload(data, length, 1, evicted);
+}
+
+/**
+ * @brief Adds a LoRa payload to the TX queue, applying the overflow policy.
+ * @param data Pointer to the payload.
+ * @param length Length of the payload.
+ * @param frames Number of host frames the payload carries.
+ * @param evicted Set to the number of host frames discarded to make room.
+ * @return True if the payload was queued.
+ */
+bool RadioManager::enqueuePayload(const uint8_t *data, size_t length, uint32_t frames, uint32_t &evicted)
+{
+    if (length > sizeof(mTxQueue[0].bytes))
+    {
+        mTxRejected++;
+        return false;
+    }
+
+    if (mTxCount == TX_QUEUE_DEPTH)
+    {
+        switch (mTxOverflow)
+        {
+        case TxOverflow_TX_OVERFLOW_DROP_OLDEST:
+            evicted = mTxFrames[mTxHead];
+            mTxDroppedOldest += evicted;
+            popTxQueue();
+            break;
+        case TxOverflow_TX_OVERFLOW_DROP_NEWEST:
+            mTxDroppedNewest++;
+            return false;
+        default:
+            mTxRejected++;
+            return false;
+        }
+    }
+
+    size_t index = (mTxHead + mTxCount) % TX_QUEUE_DEPTH;
+    memcpy(mTxQueue[index].bytes, data, length);
+    mTxQueue[index].size = length;
+    mTxQueueUs[index] = micros();
+    mTxFrames[index] = frames;
+    mTxCount++;
+    return true;
+}
+
+/**
+ * @brief Appends a frame to the payload being packed.
+ * @details A packed payload is AGGREGATE_MAGIC followed by one [length][bytes] record
+ *          per frame. When the frame does not fit, the packed payload is queued first
+ *          and the frame starts the next one; if the queue refuses it, so is the frame.
+ * @param data Pointer to the frame.
+ * @param length Length of the frame.
+ * @param evicted Set to the number of host frames discarded to make room.
+ * @return True if the frame was packed.
+ */
+bool RadioManager::packFrame(const uint8_t *data, size_t length, uint32_t &evicted)
+{
+    if (length == 0 || 2 + length > mAggregateBytes)
+    {
+        mTxRejected++;
+        return false;
+    }
+
+    if (mAggregate.size + 1 + length > mAggregateBytes)
+    {
+        if (!enqueuePayload(mAggregate.bytes, mAggregate.size, mAggregateFrames, evicted))
+            return false;
+        mAggregate.size = 0;
+        mAggregateFrames = 0;
+    }
+
+    if (mAggregateFrames == 0)
+    {
+        mAggregate.bytes[0] = AGGREGATE_MAGIC;
+        mAggregate.size = 1;
+        mAggregateStartMs = millis();
+    }
+
+    mAggregate.bytes[mAggregate.size++] = length;
+    memcpy(&mAggregate.bytes[mAggregate.size], data, length);
+    mAggregate.size += length;
+    mAggregateFrames++;
+    return true;
+}
+
+/**
+ * @brief Queues the packed frames once they fill the payload or the oldest reaches its deadline.
+ * @details Only done while the queue has room, so no queued payload is ever evicted
+ *          without the host being told.
+ * @param force True to queue the packed frames regardless of size and deadline.
+ */
+void RadioManager::flushAggregate(bool force)
+{
+    if (mAggregateFrames == 0 || mTxCount == TX_QUEUE_DEPTH)
+        return;
+
+    bool full = mAggregate.size + 2u > mAggregateBytes;
+    bool due = millis() - mAggregateStartMs >= mAggregateTimeoutMs;
+    if (force || full || due)
+    {
+        uint32_t evicted = 0;
+        enqueuePayload(mAggregate.bytes, mAggregate.size, mAggregateFrames, evicted);
+        mAggregate.size = 0;
+        mAggregateFrames = 0;
+    }
+}
+
+/**
+ * @brief Moves queued payloads to the radio.
+ * @details Starts the next payload once the previous transmission has finished. In
+ *          burst mode the next payload is written into the idle half of the radio's
+ *          buffer while the current one is still on air, so only SetTx is left to
+ *          do on TX_DONE.
+ * @return True if a payload was taken off the queue.
+ */
+bool RadioManager::serviceTxQueue()
+{
+    flushAggregate();
+
+    if (mLinkPhase != LINK_IDLE)
+        return false;
+
+    if (!transmittedFlag)
+    {
+        // Nothing is staged while a poll is due, so the poll can go out next.
+        if (!mTxBurst || mTxCount == 0 || mRequeued || linkPollDue() || !mRadio.canPreload(mTxQueue[mTxHead].size))
+            return false;
+        if (mRadio.preload(mTxQueue[mTxHead].bytes, mTxQueue[mTxHead].size) != RADIOLIB_ERR_NONE)
+            return false;
+        mPreloadFrames = mTxFrames[mTxHead];
+        mPreloadCopy = mTxQueue[mTxHead];
+        mPreloadFromQueue = true;
+        popTxQueue();
+        return true;
+    }
+
+    if (mRadio.hasPreloaded())
+    {
+        transmittedFlag = false;
+        mOnAirFrames = mPreloadFrames;
+        int state = mRadio.startPreloaded();
+        noteTxStart(true);
+        processTransmitLog(state);
+        flashLed();
+        return false;
+    }
+
+    if (mRequeued)
+    {
+        // Staged before the modulation changed, so it takes the full path this time.
+        mRequeued = false;
+        mOnAirFrames = mPreloadFrames;
+        transmit(mPreloadCopy.bytes, mPreloadCopy.size);
+        noteTxStart(true);
+        return false;
+    }
+
+    if (mTxCount == 0)
+        return false;
+
+    // startTransmit() copies the payload into the radio, so the slot is free on return.
+    bool waiting = static_cast<int32_t>(mTxDoneUs - mTxQueueUs[mTxHead]) >= 0;
+    mOnAirFrames = mTxFrames[mTxHead];
+    transmit(mTxQueue[mTxHead].bytes, mTxQueue[mTxHead].size);
+    noteTxStart(waiting);
+    popTxQueue();
+    return true;
+}
+
+/**
+ * @brief Starts a transmission right away if the radio is free, bypassing the TX queue.
+ * @details Uses the payload staged with preloadTransmission() if there is one, so only
+ *          SetTx is sent. The transmit log is produced after the packet is on its way.
+ *          Called from the TxScheduler task; takes mLock.
+ * @param data Pointer to the data to be transmitted if nothing is staged.
+ * @param length Length of the data to be transmitted.
+ * @param startUs Set to micros() right after the radio was told to transmit.
+ * @return False if the previous transmission has not finished yet.
+ */
+bool RadioManager::startTransmission(const uint8_t *data, size_t length, uint32_t &startUs)
+{
+    xSemaphoreTake(mLock, portMAX_DELAY);
+    if (!transmittedFlag)
+    {
+        xSemaphoreGive(mLock);
+        return false;
+    }
+
+    transmittedFlag = false;
+    int state = mRadio.hasPreloaded() ? mRadio.startPreloaded() : mRadio.startTransmit(data, length);
+    startUs = micros();
+
+    noteTxStart(false);
+    mOnAirFrames = 1;
+    processTransmitLog(state);
+    flashLed();
+    xSemaphoreGive(mLock);
+    return true;
+}
+
+/**
+ * @brief Writes the next payload into the idle half of the radio's buffer.
+ * @param data Pointer to the payload.
+ * @param length Length of the payload.
+ * @return True if the payload is staged for startTransmission().
+ */
+bool RadioManager::preloadTransmission(const uint8_t *data, size_t length)
+{
+    xSemaphoreTake(mLock, portMAX_DELAY);
+    bool staged = mLinkPhase == LINK_IDLE && !linkPollDue() && mRadio.canPreload(length) &&
+                  mRadio.preload(data, length) == RADIOLIB_ERR_NONE;
+    if (staged)
+    {
+        mPreloadFromQueue = false;
+    }
+    xSemaphoreGive(mLock);
+    return staged;
+}
+
+/**
+ * @brief Drops the payload staged with preloadTransmission(), if any.
+ */
+void RadioManager::discardPreloaded()
+{
+    xSemaphoreTake(mLock, portMAX_DELAY);
+    mRadio.discardPreloaded();
+    xSemaphoreGive(mLock);
+}
+
+/**
+ * @brief Drops the staged payload from the radio after the modulation changed.
+ * @details startPreloaded() skips the sensitivity fix startTransmit() applies, which
+ *          depends on the bandwidth, so the next packet has to take the full path. A
+ *          payload from the TX queue goes out next, ahead of the queue; one staged by
+ *          the TxScheduler is still held there and sent with startTransmit().
+ */
+void RadioManager::unstagePreloaded()
+{
+    if (!mRadio.hasPreloaded())
+        return;
+
+    mRadio.discardPreloaded();
+    mRequeued = mPreloadFromQueue;
+}
+
+/**
+ * @brief Removes the oldest payload from the TX queue.
+ */
+void RadioManager::popTxQueue()
+{
+    mTxHead = (mTxHead + 1) % TX_QUEUE_DEPTH;
+    mTxCount--;
+}
+
+/**
+ * @brief Counts a started transmission and records the idle gap since the previous TX_DONE.
+ * @param waiting True if the payload was ready before the previous transmission finished,
+ *                so the gap is down to the firmware rather than the host.
+ */
+void RadioManager::noteTxStart(bool waiting)
+{
+    if (waiting && mTxStarted > 0)
+    {
+        mTxGap.add(micros() - mTxDoneUs);
+    }
+    mTxStarted++;
+    mAdapter.noteSent();
+}
+
+/**
+ * @brief Fills the radio transmit counters of a Stats message.
+ * @param stats Reference to the Stats structure to be filled.
+ */
+void RadioManager::fillStats(Stats &stats) const
+{
+    stats.tx_started = mTxStarted;
+    stats.has_tx_gap = true;
+    mTxGap.fill(stats.tx_gap);
+    stats.has_rx_turnaround = true;
+    mRxTurnaround.fill(stats.rx_turnaround);
+    stats.rx_capture_dropped = mRxCaptureDropped;
+    stats.has_reconfigure_time = true;
+    mReconfigureTime.fill(stats.reconfigure_time);
+    stats.image_calibrations = mImageCalibrations;
+}
+
 /**
  * @brief Starts the radio module in receive mode.
  * @details Assisted by: Jingkai Lin
@@ -128,8 +658,79 @@ void RadioManager::startReceive(void)
 }
 
 /**
- * @brief Processes the reception log after receiving data, otherwise log RSSI values during reception.
- * @details Assisted by: Jingkai Lin
+ * @brief Handles reception from the main loop when built with RADIO_RX_IN_LOOP.
+ * @details Otherwise the radio task does this and there is nothing left for the loop.
+ */
+void RadioManager::pollReception()
+{
+#ifdef RADIO_RX_IN_LOOP
+    xSemaphoreTake(mLock, portMAX_DELAY);
+    processReceptionLog();
+    xSemaphoreGive(mLock);
+
+    xSemaphoreTake(mLogLock, portMAX_DELAY);
+    drainCaptures();
+    if (mBatchCount > 0 && mBatchTimeoutMs > 0 && millis() - mBatchStartMs >= mBatchTimeoutMs)
+    {
+        flushLogBatch();
+    }
+    xSemaphoreGive(mLogLock);
+#endif
+}
+
+/**
+ * @brief Radio task: waits for the DIO1 interrupt or the RSSI timer and handles reception.
+ * @param param Pointer to the RadioManager.
+ */
+void RadioManager::radioTask(void *param)
+{
+    RadioManager *self = static_cast<RadioManager *>(param);
+    for (;;)
+    {
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+
+        xSemaphoreTake(self->mLock, portMAX_DELAY);
+        if (self->state == State_RECEIVER)
+        {
+            self->processReceptionLog();
+        }
+        xSemaphoreGive(self->mLock);
+    }
+}
+
+/**
+ * @brief Log task: turns the packets captured by the radio task into reception logs.
+ * @details While reception logs wait in a batch it also wakes to check the deadline.
+ * @param param Pointer to the RadioManager.
+ */
+void RadioManager::logTask(void *param)
+{
+    RadioManager *self = static_cast<RadioManager *>(param);
+    for (;;)
+    {
+        TickType_t wait = self->mBatchCount > 0 ? pdMS_TO_TICKS(BATCH_POLL_MS) : portMAX_DELAY;
+        uint8_t slot;
+        bool captured = xQueueReceive(self->mCaptureReady, &slot, wait) == pdTRUE;
+
+        xSemaphoreTake(self->mLogLock, portMAX_DELAY);
+        if (captured)
+        {
+            self->processCapture(slot);
+        }
+        if (self->mBatchCount > 0 && self->mBatchTimeoutMs > 0 && millis() - self->mBatchStartMs >= self->mBatchTimeoutMs)
+        {
+            self->flushLogBatch();
+        }
+        xSemaphoreGive(self->mLogLock);
+    }
+}
+
+/**
+ * @brief Captures a received packet and restarts reception, otherwise log RSSI values during reception.
+ * @details Assisted by: Jingkai Lin. The caller holds mLock. Only what has to come from the
+ *          radio before RX restarts is read here; the capture is handed to the log task for
+ *          everything else. If every capture slot is still waiting, the packet is dropped
+ *          rather than delaying the restart.
  */
 void RadioManager::processReceptionLog()
 {
@@ -138,134 +739,738 @@ void RadioManager::processReceptionLog()
     {
         flashLed();
         receivedFlag = false;
+        int64_t irqUs = readStamp(mIrqTimeUs); // taken before the flags, so it is not newer than them
+#ifndef RADIO_RX_IN_LOOP
+        // Read here rather than in the ISR, which must not block on SPI.
+        setIrqType();
+#endif
 
-        // If header valid is detected, start polling for instant RSSI.
-        if (irqType & RADIOLIB_SX126X_IRQ_HEADER_VALID)
+        // If header valid is detected, start sampling instant RSSI until the packet is done.
+        if ((irqType & RADIOLIB_SX126X_IRQ_HEADER_VALID) && !(irqType & RADIOLIB_SX126X_IRQ_RX_DONE))
         {
-            instRssiFlag = true;
+            mHeaderTimeUs = irqUs;
+            startRssiSampling();
         }
 
-        // If the packet is fully received, process the complete packet.
+        // If the packet is fully received, capture it and get the radio listening again.
         if (irqType & RADIOLIB_SX126X_IRQ_RX_DONE)
         {
-            instRssiFlag = false; // Stop RSSI polling
+            stopRssiSampling();
 
-            Log log = Log_init_zero;
-            size_t loraPacketLength = mRadio.getPacketLength();
-            int state = mRadio.readData(log.payload.bytes, loraPacketLength);
-            log.payload.size = loraPacketLength;
+            uint8_t slot;
+            bool captured = xQueueReceive(mCaptureFree, &slot, 0) == pdTRUE;
+            if (captured)
+            {
+                Log &log = mCapture[slot];
+                memset(&log, 0, sizeof(log)); // Log_init_zero, without a temporary on this small stack
+                size_t loraPacketLength = mRadio.getPacketLength();
+                int state = mRadio.readData(log.payload.bytes, loraPacketLength);
+                log.payload.size = loraPacketLength;
 
-            // Limit RSSI log to 400 entries (avoid overflow)
-            size_t rssiCount = std::min(rssiLog.size(), static_cast<size_t>(400));
-            log.rssi_log.size = rssiCount * sizeof(int32_t);
-            for (size_t i = 0; i < rssiCount; ++i)
+                log.rssi_avg = mRadio.getRSSI();
+                log.snr = mRadio.getSNR();
+                log.crc_error = (state == RADIOLIB_ERR_CRC_MISMATCH);
+                log.general_error = (state != RADIOLIB_ERR_NONE && !log.crc_error);
+                log.header_valid_us = mHeaderTimeUs;
+                log.rx_done_us = irqUs;
+            }
+            else
             {
-                int32_t rssi = rssiLog[i];
-                memcpy(&log.rssi_log.bytes[i * sizeof(int32_t)], &rssi, sizeof(int32_t));
+                mRxCaptureDropped++;
             }
-            rssiLog.clear();
 
-            log.has_gps = true;
-            ProcessGPSData(log.gps);
+            // A poll is answered before RX restarts and is not logged.
+            bool polled = captured && answerPoll(mCapture[slot]);
 
-            log.rssi_avg = mRadio.getRSSI();
-            log.snr = mRadio.getSNR();
-            log.crc_error = (state == RADIOLIB_ERR_CRC_MISMATCH);
-            log.general_error = (state != RADIOLIB_ERR_NONE && !log.crc_error);
+            mRadio.clearIrqFlags(RADIOLIB_SX126X_IRQ_ALL);
+            startReceive();
+            if (!polled)
+            {
+                mRxTurnaround.add(static_cast<uint32_t>(esp_timer_get_time() - irqUs));
+            }
+
+            // The samples are only overwritten once this task sees the next header, so they
+            // can be packed after the restart.
+            if (polled)
+            {
+                xQueueSend(mCaptureFree, &slot, 0);
+            }
+            else if (captured)
+            {
+                Log &log = mCapture[slot];
+                encodeRssiLog(log);
+                log.rssi_period_us = mRssiPeriodUs;
+                log.rssi_missed = mRssiMissed;
+                log.time_on_air_us = static_cast<uint32_t>(mRadio.getTimeOnAir(log.payload.size));
+                xQueueSend(mCaptureReady, &slot, 0);
+            }
+            mRssiCount = 0;
+            mHeaderTimeUs = 0;
+        }
+    }
+
+    // Take the sample the RSSI timer asked for, if the packet is still arriving.
+    uint32_t due = mRssiDue;
+    if (instRssiFlag && due != mRssiHandled)
+    {
+        mRssiMissed += due - mRssiHandled - 1;
+        mRssiHandled = due;
+        sampleRssi();
+    }
+}
 
-            TxSerialLogPacket(log);
+/**
+ * @brief Turns a captured packet into one or more reception logs and frees its slot.
+ * @details The caller holds mLogLock.
+ * @param slot Index of the filled capture slot.
+ */
+void RadioManager::processCapture(uint8_t slot)
+{
+    Log &log = mCapture[slot];
+    log.has_gps = true;
+    mGps.read(log.gps);
+    stampUtc(log);
+
+    if (mProbe.enabled() && mProbe.add(log))
+    {
+        sendProbeReport();
+    }
+
+    if (mAggregateBytes == 0 || !queueAggregateLogs(log))
+    {
+        queueReceptionLog(log);
+    }
+
+    xQueueSend(mCaptureFree, &slot, 0);
+}
+
+/**
+ * @brief Queues the probe test results of the current window for the serial connection.
+ */
+void RadioManager::sendProbeReport()
+{
+    Packet packet = Packet_init_zero;
+    packet.type = PacketType_PROBE_REPORT;
+    packet.has_probe_report = true;
+    mProbe.fillReport(packet.probe_report);
 
-            // Clear IRQ flags after full packet processing and restart reception.
+    mSerialTx.sendPacket(packet);
+}
+
+/**
+ * @brief Processes every capture still waiting, oldest first; the caller holds mLogLock.
+ */
+void RadioManager::drainCaptures()
+{
+    uint8_t slot;
+    while (xQueueReceive(mCaptureReady, &slot, 0) == pdTRUE)
+    {
+        processCapture(slot);
+    }
+}
+
+/**
+ * @brief Runs the main loop's part of link adaptation and sends the decisions to the host.
+ * @details On the transmitter this drives the poll exchange; on the receiver it falls
+ *          back to rung 0 when the transmitter has not been heard for a while.
+ */
+void RadioManager::pollLinkAdaptation()
+{
+    if (!mAdapter.enabled())
+        return;
+
+    xSemaphoreTake(mLock, portMAX_DELAY);
+    if (state == State_TRANSMITTER)
+    {
+        pollFeedback();
+    }
+    else if (state == State_RECEIVER)
+    {
+        LinkAdapt decision;
+        if (mAdapter.checkLost(millis(), decision))
+        {
+            mRadio.standby();
+            applyRung(decision);
+            startReceive();
+            queueAdaptEvent(decision);
+        }
+    }
+
+    LinkAdapt events[ADAPT_EVENTS];
+    size_t count = mAdaptEventCount;
+    memcpy(events, mAdaptEvents, count * sizeof(LinkAdapt));
+    mAdaptEventCount = 0;
+    xSemaphoreGive(mLock);
+
+    for (size_t i = 0; i < count; ++i)
+    {
+        Packet &packet = mSerialTx.reply();
+        packet.type = PacketType_LINK_ADAPT;
+        packet.has_link_adapt = true;
+        packet.link_adapt = events[i];
+        mSerialTx.sendPacket(packet);
+    }
+}
+
+/**
+ * @brief Checks whether the transmitter should poll the receiver once the radio is free.
+ * @return True if adaptation is on and the poll interval has passed.
+ */
+bool RadioManager::linkPollDue() const
+{
+    return mAdapter.enabled() && state == State_TRANSMITTER && millis() - mPollMs >= mAdapter.intervalMs();
+}
+
+/**
+ * @brief Advances the transmitter's poll exchange; the caller holds mLock.
+ * @details The poll goes out once the radio is idle with nothing staged. After its
+ *          TX_DONE the radio listens for two feedback airtimes plus FEEDBACK_GUARD_MS,
+ *          then returns to transmitting with the rung the feedback led to.
+ */
+void RadioManager::pollFeedback()
+{
+    switch (mLinkPhase)
+    {
+    case LINK_IDLE:
+    {
+        if (!linkPollDue() || !transmittedFlag || mRadio.hasPreloaded())
+            return;
+
+        LinkAdapter::Frame poll;
+        mAdapter.makePoll(poll);
+        uint8_t payload[LinkAdapter::FRAME_SIZE];
+        size_t length = LinkAdapter::writeFrame(poll, payload);
+        mPollMs = millis();
+        transmittedFlag = false;
+        if (mRadio.startTransmit(payload, length) != RADIOLIB_ERR_NONE)
+        {
+            transmittedFlag = true; // no TX_DONE will come; try again next interval
+            return;
+        }
+        mLinkPhase = LINK_POLLING;
+        return;
+    }
+    case LINK_POLLING:
+        if (!transmittedFlag)
+            return;
+
+        receivedFlag = false;
+        mRadio.setPacketReceivedAction(receivedISR);
+        startReceive();
+        mListenWindowMs = 2 * static_cast<uint32_t>(mRadio.getTimeOnAir(LinkAdapter::FRAME_SIZE) / 1000) + FEEDBACK_GUARD_MS;
+        mListenMs = millis();
+        mLinkPhase = LINK_LISTENING;
+        return;
+    case LINK_LISTENING:
+        break;
+    }
+
+    LinkAdapter::Frame feedback;
+    bool heard = false;
+    if (receivedFlag)
+    {
+        receivedFlag = false;
+        if (!(mRadio.getIrqFlags() & RADIOLIB_SX126X_IRQ_RX_DONE))
+            return; // only the header so far
+
+        uint8_t payload[LinkAdapter::FRAME_SIZE];
+        heard = mRadio.getPacketLength() == LinkAdapter::FRAME_SIZE &&
+                mRadio.readData(payload, LinkAdapter::FRAME_SIZE) == RADIOLIB_ERR_NONE &&
+                LinkAdapter::readFrame(payload, LinkAdapter::FRAME_SIZE, feedback) && mAdapter.isFeedback(feedback);
+        if (!heard && millis() - mListenMs < mListenWindowMs)
+        {
+            // Something else; keep listening for the feedback.
             mRadio.clearIrqFlags(RADIOLIB_SX126X_IRQ_ALL);
             startReceive();
+            return;
+        }
+    }
+    else if (millis() - mListenMs < mListenWindowMs)
+    {
+        return;
+    }
+
+    abortPoll();
+
+    LinkAdapt decision;
+    bool decided = heard ? mAdapter.onFeedback(feedback, decision) : mAdapter.onMissedFeedback(decision);
+    if (decided)
+    {
+        if (decision.applied)
+        {
+            applyRung(decision);
         }
+        queueAdaptEvent(decision);
+    }
+}
+
+/**
+ * @brief Ends the transmitter's poll exchange, if one is under way, and readies the radio to transmit.
+ */
+void RadioManager::abortPoll()
+{
+    if (mLinkPhase == LINK_IDLE)
+        return;
+
+    mRadio.standby();
+    mRadio.setPacketSentAction(transmittedISR);
+    transmittedFlag = true;
+    mLinkPhase = LINK_IDLE;
+}
+
+/**
+ * @brief Answers a poll from the transmitter, from the radio task with mLock held.
+ * @details The feedback is sent right away at the current rung; if the poll proposed
+ *          another rung, the radio switches to it afterwards. Packets that are not polls
+ *          are only counted for the next feedback.
+ * @param log Reference to the capture of the packet just received.
+ * @return True if the packet was a poll, which is then not logged.
+ */
+bool RadioManager::answerPoll(const Log &log)
+{
+    LinkAdapter::Frame poll;
+    if (!mAdapter.enabled() || log.crc_error || log.general_error ||
+        !mAdapter.receive(log.payload.bytes, log.payload.size, log.snr, log.rssi_avg, millis(), poll))
+        return false;
+
+    LinkAdapter::Frame feedback;
+    LinkAdapt decision;
+    bool switching = mAdapter.answer(poll, feedback, decision);
+    uint8_t payload[LinkAdapter::FRAME_SIZE];
+    size_t length = LinkAdapter::writeFrame(feedback, payload);
+    mRadio.transmit(payload, length);
+    receivedFlag = false; // the TX_DONE interrupt lands in receivedISR too
+
+    if (switching)
+    {
+        applyRung(decision);
+        queueAdaptEvent(decision);
+    }
+    return true;
+}
+
+/**
+ * @brief Switches the radio to the rung of an adaptation decision; the caller holds mLock.
+ * @details Only the parameters that differ from the current rung are sent. If the radio
+ *          refuses the rung, it goes back to decision.previous_rung, the LinkAdapter stays
+ *          there too and the decision is reported as not applied.
+ * @param decision Reference to the decision, with applied cleared if the switch failed.
+ * @return True if the radio took the rung's settings.
+ */
+bool RadioManager::applyRung(LinkAdapt &decision)
+{
+    Settings config = mApplied;
+    mAdapter.applyRung(decision.rung, config);
+
+    int64_t startUs = esp_timer_get_time();
+    bool changed = false;
+    bool ok = applyRadioSettings(config, changed);
+    if (!ok)
+    {
+        Serial.printf("Error: Unable to switch to rung %u, staying on rung %u\n",
+                      static_cast<unsigned>(decision.rung), static_cast<unsigned>(decision.previous_rung));
+        config = mApplied;
+        mAdapter.applyRung(decision.previous_rung, config);
+        bool reverted = false;
+        applyRadioSettings(config, reverted);
+        changed = changed || reverted;
+        mAdapter.revertRung(decision.previous_rung);
+        decision.applied = false;
+    }
+    if (changed)
+    {
+        mReconfigureTime.add(static_cast<uint32_t>(esp_timer_get_time() - startUs));
+        mTxGap.reset();
+    }
+    updateRssiPeriod();
+    return ok;
+}
+
+/**
+ * @brief Keeps an adaptation decision for pollLinkAdaptation() to send; the caller holds mLock.
+ * @details If the main loop has fallen behind, the oldest decision waiting is dropped.
+ * @param decision Reference to the decision.
+ */
+void RadioManager::queueAdaptEvent(const LinkAdapt &decision)
+{
+    if (mAdaptEventCount == ADAPT_EVENTS)
+    {
+        memmove(mAdaptEvents, mAdaptEvents + 1, (ADAPT_EVENTS - 1) * sizeof(LinkAdapt));
+        mAdaptEventCount--;
     }
+    mAdaptEvents[mAdaptEventCount++] = decision;
+}
+
+/**
+ * @brief RSSI timer callback, runs in the esp_timer task and only hands the tick on.
+ * @param arg Pointer to the RadioManager.
+ */
+void RadioManager::rssiTimerCallback(void *arg)
+{
+    RadioManager *self = static_cast<RadioManager *>(arg);
+    self->mRssiDue++;
+#ifndef RADIO_RX_IN_LOOP
+    xTaskNotifyGive(self->mTaskHandle);
+#endif
+}
+
+/**
+ * @brief Starts fixed-rate RSSI sampling for the packet whose header just arrived.
+ * @details The first sample is taken right away, the rest every mRssiPeriodUs, so
+ *          sample i of Log.rssi_log is i periods after the valid header.
+ */
+void RadioManager::startRssiSampling()
+{
+    esp_timer_stop(mRssiTimer);
+    mRssiCount = 0;
+    mRssiMissed = 0;
+    mRssiHandled = mRssiDue;
+    memset(mRssiHistogram, 0, sizeof(mRssiHistogram));
+    instRssiFlag = true;
+    sampleRssi();
+    esp_timer_start_periodic(mRssiTimer, mRssiPeriodUs);
+}
 
-    // Poll RSSI continuously only while polling is enabled.
-    if (instRssiFlag)
+/**
+ * @brief Stops RSSI sampling; the samples taken so far are kept.
+ */
+void RadioManager::stopRssiSampling()
+{
+    instRssiFlag = false;
+    esp_timer_stop(mRssiTimer);
+}
+
+/**
+ * @brief Reads the instantaneous RSSI into the next sample slot.
+ * @details The SX126x reports it as -raw/2 dBm, so the raw byte is kept and nothing is lost.
+ */
+void RadioManager::sampleRssi()
+{
+    uint8_t raw = static_cast<uint8_t>(-2.0f * mRadio.getRSSI(false));
+    mRssiHistogram[raw]++;
+    if (mRssiEncoding == RssiEncoding_RSSI_SUMMARY)
+        return; // no trace is kept, so the packet is sampled to its end
+
+    mRssiSamples[mRssiCount++] = raw;
+    if (mRssiCount == MAX_RSSI_SAMPLES)
     {
-        // Optionally, limit the size of rssiLog to prevent overflow:
-        if (rssiLog.size() < 100)
+        stopRssiSampling();
+    }
+}
+
+/**
+ * @brief Packs the RSSI samples of the packet just received into Log.rssi_log.
+ * @details RSSI_INT32 keeps the old layout of one little-endian int32 dBm value per sample,
+ *          which fits a quarter of the samples. RSSI_HALF_DB stores each raw sample as one
+ *          byte. RSSI_DELTA stores zigzag varints of the difference to the previous raw sample,
+ *          mostly one byte each. Samples that do not fit are dropped from the end.
+ * @param log Reference to the Log the samples are written to.
+ */
+void RadioManager::encodeRssiLog(Log &log) const
+{
+    const size_t capacity = sizeof(log.rssi_log.bytes);
+    size_t size = 0;
+    log.rssi_encoding = mRssiEncoding;
+
+    switch (mRssiEncoding)
+    {
+    case RssiEncoding_RSSI_SUMMARY:
+        log.has_rssi_summary = true;
+        summarizeRssi(log.rssi_summary);
+        break;
+    case RssiEncoding_RSSI_HALF_DB:
+        size = mRssiCount;
+        memcpy(log.rssi_log.bytes, mRssiSamples, size);
+        break;
+    case RssiEncoding_RSSI_DELTA:
+    {
+        int32_t previous = 0;
+        for (size_t i = 0; i < mRssiCount; ++i)
+        {
+            int32_t delta = static_cast<int32_t>(mRssiSamples[i]) - previous;
+            uint32_t zigzag = (static_cast<uint32_t>(delta) << 1) ^ static_cast<uint32_t>(delta >> 31);
+            if (size + (zigzag < 0x80 ? 1 : 2) > capacity)
+                break;
+            while (zigzag >= 0x80)
+            {
+                log.rssi_log.bytes[size++] = static_cast<uint8_t>(zigzag | 0x80);
+                zigzag >>= 7;
+            }
+            log.rssi_log.bytes[size++] = static_cast<uint8_t>(zigzag);
+            previous = mRssiSamples[i];
+        }
+        break;
+    }
+    default:
+        for (size_t i = 0; i < mRssiCount && size + sizeof(int32_t) <= capacity; ++i)
         {
-            rssiLog.push_back(mRadio.getRSSI(false));
+            int32_t dbm = -static_cast<int32_t>(mRssiSamples[i] / 2);
+            memcpy(&log.rssi_log.bytes[size], &dbm, sizeof(dbm));
+            size += sizeof(dbm);
         }
+        break;
+    }
+
+    log.rssi_log.size = size;
+}
+
+/**
+ * @brief Summarises the RSSI samples of the packet just received from their histogram.
+ * @details The histogram is kept per raw half-dB value while sampling, so the summary
+ *          costs one increment per sample and covers the whole packet however long it is.
+ *          Percentiles are nearest-rank, in dBm, with p10 the weakest tenth.
+ * @param summary Reference to the RssiSummary to be filled.
+ */
+void RadioManager::summarizeRssi(RssiSummary &summary) const
+{
+    uint32_t count = 0;
+    uint64_t sum = 0;
+    uint64_t sumSquares = 0;
+    for (uint32_t raw = 0; raw < 256; ++raw)
+    {
+        count += mRssiHistogram[raw];
+        sum += static_cast<uint64_t>(raw) * mRssiHistogram[raw];
+        sumSquares += static_cast<uint64_t>(raw * raw) * mRssiHistogram[raw];
+    }
+
+    summary = RssiSummary_init_zero;
+    summary.count = count;
+    if (count == 0)
+        return;
+
+    float meanRaw = static_cast<float>(sum) / count;
+    summary.mean = -meanRaw / 2;
+    summary.variance = std::max(static_cast<float>(sumSquares) / count - meanRaw * meanRaw, 0.0f) / 4;
+
+    // A larger raw value is a weaker signal, so walk from the top for ascending dBm.
+    const uint32_t ranks[3] = {(count * 10 + 99) / 100, (count * 50 + 99) / 100, (count * 90 + 99) / 100};
+    float *percentiles[3] = {&summary.p10, &summary.p50, &summary.p90};
+    uint32_t seen = 0;
+    size_t next = 0;
+    for (int raw = 255; raw >= 0; --raw)
+    {
+        if (mRssiHistogram[raw] == 0)
+            continue;
+        if (seen == 0)
+            summary.min = -raw / 2.0f;
+        summary.max = -raw / 2.0f;
+        seen += mRssiHistogram[raw];
+        while (next < 3 && seen >= ranks[next])
+            *percentiles[next++] = -raw / 2.0f;
     }
 }
 
+/**
+ * @brief Adds a reception log to the current batch, or sends it on its own when batching is disabled.
+ * @details The batch carries the position taken with its first log. Each log keeps its
+ *          offset from the start of the batch and its position as a delta from the log
+ *          before it, which is zero and so not encoded while the receiver stands still.
+ *          The deltas wrap modulo 2^32, as does the host's sum of them.
+ * @param log Reference to the Log structure to be queued.
+ */
+void RadioManager::queueReceptionLog(const Log &log)
+{
+    if (mBatchSize <= 1)
+    {
+        memset(&mLogPacket, 0, sizeof(mLogPacket)); // Packet_init_zero, without a temporary on the stack
+        mLogPacket.log = log;
+        TxSerialLogPacket(mLogPacket);
+        return;
+    }
+
+    uint32_t now = millis();
+    if (mBatchCount == 0)
+    {
+        mBatchStartMs = now;
+        mBatchGps = log.gps;
+        mBatchLastGps = log.gps;
+    }
+
+    Log &entry = mBatch[mBatchCount++];
+    entry = log;
+    entry.batch_offset_ms = now - mBatchStartMs;
+    entry.gps.delta = true;
+    entry.gps.latitude_e7 = static_cast<int32_t>(static_cast<uint32_t>(log.gps.latitude_e7) - static_cast<uint32_t>(mBatchLastGps.latitude_e7));
+    entry.gps.longitude_e7 = static_cast<int32_t>(static_cast<uint32_t>(log.gps.longitude_e7) - static_cast<uint32_t>(mBatchLastGps.longitude_e7));
+    mBatchLastGps = log.gps;
+
+    if (mBatchCount >= mBatchSize)
+    {
+        flushLogBatch();
+    }
+}
+
+/**
+ * @brief Queues one reception log per frame of a packed payload.
+ * @details The frames share the measurements and position of the packet they arrived
+ *          in; the RSSI trace or summary is only kept on the first so it is not repeated per frame.
+ * @param log Reference to the reception log of the whole packet.
+ * @return False if the payload is not a well-formed packed payload, in which case nothing is queued.
+ */
+bool RadioManager::queueAggregateLogs(const Log &log)
+{
+    const uint8_t *bytes = log.payload.bytes;
+    size_t size = log.payload.size;
+    if (log.crc_error || log.general_error || size < 2 || bytes[0] != AGGREGATE_MAGIC)
+        return false;
+
+    // Walk the records once first so a malformed packet is reported whole, as received.
+    uint32_t frames = 0;
+    size_t pos = 1;
+    while (pos < size)
+    {
+        if (bytes[pos] == 0)
+            return false;
+        pos += 1 + bytes[pos];
+        frames++;
+    }
+    if (pos != size)
+        return false;
+
+    Log frameLog = log;
+    pos = 1;
+    for (uint32_t i = 0; i < frames; ++i)
+    {
+        uint8_t length = bytes[pos];
+        memcpy(frameLog.payload.bytes, &bytes[pos + 1], length);
+        frameLog.payload.size = length;
+        frameLog.frame_index = i;
+        frameLog.frame_count = frames;
+        queueReceptionLog(frameLog);
+
+        frameLog.rssi_log.size = 0;
+        frameLog.has_rssi_summary = false;
+        pos += 1 + length;
+    }
+    return true;
+}
+
+/**
+ * @brief Queues all batched reception logs as a single LogBatch packet for the serial connection.
+ * @details The caller holds mLogLock.
+ */
+void RadioManager::flushLogBatch()
+{
+    if (mBatchCount == 0)
+        return;
+
+    Packet &packet = mLogPacket;
+    memset(&packet, 0, sizeof(packet)); // Packet_init_zero, without a temporary on the stack
+    packet.type = PacketType_LOG_BATCH;
+    packet.has_log_batch = true;
+    packet.log_batch.has_gps = true;
+    packet.log_batch.gps = mBatchGps;
+    packet.log_batch.start_ms = mBatchStartMs;
+    packet.log_batch.logs.funcs.encode = encodeBatchLogs;
+    packet.log_batch.logs.arg = this;
+
+    // The packet is encoded into the serial ring before this returns, so mBatch can be reused.
+    mSerialTx.sendPacket(packet);
+    mBatchCount = 0;
+}
+
+/**
+ * @brief Nanopb callback that encodes the batched logs as the repeated LogBatch.logs field.
+ * @param stream Output stream.
+ * @param field Descriptor of the logs field.
+ * @param arg Pointer to the RadioManager owning the batch.
+ * @return True if every log was encoded.
+ */
+bool RadioManager::encodeBatchLogs(pb_ostream_t *stream, const pb_field_t *field, void *const *arg)
+{
+    const RadioManager *self = static_cast<const RadioManager *>(*arg);
+    for (size_t i = 0; i < self->mBatchCount; ++i)
+    {
+        if (!pb_encode_tag_for_field(stream, field) || !pb_encode_submessage(stream, Log_fields, &self->mBatch[i]))
+            return false;
+    }
+    return true;
+}
+
 /**
  * @brief Processes the transmission log after transmitting data.
+ * @details Called right after the radio was told to transmit, so the log carries the start
+ *          of this packet but the TX_DONE of the previous one.
  * @param state The state returned by the radio module after transmission.
  */
 void RadioManager::processTransmitLog(int state)
 {
-    Log log = Log_init_zero;
+    // Built in place: this runs deep in the main loop's transmit path, whose stack has no room for a Log and a Packet.
+    memset(&mTxLogPacket, 0, sizeof(mTxLogPacket)); // Packet_init_zero, without a temporary on the stack
+    Log &log = mTxLogPacket.log;
+    log.tx_start_us = esp_timer_get_time();
+    log.prev_tx_done_us = readStamp(mTxDoneTimeUs);
+    log.time_on_air_us = static_cast<uint32_t>(mRadio.getTimeOnAir(mRadio.onAirLength()));
 
     log.has_gps = true;
-    ProcessGPSData(log.gps);
+    mGps.read(log.gps);
+    stampUtc(log);
     log.general_error = (state != RADIOLIB_ERR_NONE);
+    log.tx_queued = mTxCount;
+    log.tx_rejected = mTxRejected;
+    log.tx_dropped_newest = mTxDroppedNewest;
+    log.tx_dropped_oldest = mTxDroppedOldest;
+    log.frame_count = mOnAirFrames;
 
-    TxSerialLogPacket(log);
+    TxSerialLogPacket(mTxLogPacket);
 }
 
 /**
- * @brief Processes GPS data and fills the provided Gps structure.
- * @param gpsData Reference to the Gps structure to be filled.
+ * @brief Reads a timestamp written by the DIO1 interrupt.
+ * @details The 64-bit value takes two stores, so it is read under the same lock the ISR takes.
+ * @param stamp Reference to the timestamp.
+ * @return The esp_timer_get_time() value of the interrupt.
  */
-void RadioManager::ProcessGPSData(Gps &gpsData)
+int64_t RadioManager::readStamp(const volatile int64_t &stamp)
 {
-    while (gpsSerial.available())
+    portENTER_CRITICAL(&mIrqMux);
+    int64_t value = stamp;
+    portEXIT_CRITICAL(&mIrqMux);
+    return value;
+}
+
+/**
+ * @brief Converts the esp_timer stamps of a log to UTC and records how well they are known.
+ * @details Stamps that were never taken stay 0. The error is that of the newest stamp;
+ *          the others are at most a packet's time on air older.
+ * @param log Reference to the Log whose stamps are converted.
+ */
+void RadioManager::stampUtc(Log &log)
+{
+    uint64_t *stamps[] = {&log.header_valid_us, &log.rx_done_us, &log.prev_tx_done_us, &log.tx_start_us};
+    for (uint64_t *stamp : stamps)
     {
-        if (gps.encode(gpsSerial.read()))
+        if (*stamp)
         {
-            gpsData.latitude = gps.location.isValid() ? gps.location.lat() : 0;
-            gpsData.longitude = gps.location.isValid() ? gps.location.lng() : 0;
-            gpsData.satellites = gps.satellites.isValid() ? gps.satellites.value() : 0;
+            log.clock_source = mClock.toUtc(static_cast<int64_t>(*stamp), *stamp, log.clock_error_us);
         }
     }
 }
 
 /**
- * @brief Transmits a log packet over the serial connection.
- * @param log Reference to the Log structure to be transmitted.
+ * @brief Queues a log packet for the serial connection.
+ * @param packet Reference to a member packet whose log has been filled in.
  */
-void RadioManager::TxSerialLogPacket(const Log &log)
+void RadioManager::TxSerialLogPacket(Packet &packet)
 {
-    Packet packet = Packet_init_zero;
     packet.has_log = true;
     packet.type = PacketType_LOG;
-    packet.log = log;
-
-    uint8_t buffer[Packet_size];
-    pb_ostream_t stream = pb_ostream_from_buffer(buffer, sizeof(buffer));
 
-    if (pb_encode(&stream, Packet_fields, &packet))
-    {
-        Serial.write(START_DELIMITER, START_LEN);
-        Serial.write(buffer, stream.bytes_written);
-        Serial.write(END_DELIMITER, END_LEN);
-    }
+    mSerialTx.sendPacket(packet);
 }
 
 /**
- * @brief Transmits a GPS packet over the serial connection.
+ * @brief Queues a GPS packet for the serial connection.
  */
 void RadioManager::TxSerialGPSPacket()
 {
-    Packet packet = Packet_init_zero;
+    Packet &packet = mSerialTx.reply();
     packet.has_gps = true;
     packet.type = PacketType_GPS;
 
-    ProcessGPSData(packet.gps);
+    mGps.read(packet.gps);
 
-    uint8_t buffer[Packet_size];
-    pb_ostream_t stream = pb_ostream_from_buffer(buffer, sizeof(buffer));
-
-    if (pb_encode(&stream, Packet_fields, &packet))
-    {
-        Serial.write(START_DELIMITER, START_LEN);
-        Serial.write(buffer, stream.bytes_written);
-        Serial.write(END_DELIMITER, END_LEN);
-    }
+    mSerialTx.sendPacket(packet);
 }
 
 /**
@@ -274,6 +1479,36 @@ void RadioManager::TxSerialGPSPacket()
  */
 void RadioManager::setState(State newState)
 {
+    xSemaphoreTake(mLock, portMAX_DELAY);
+    xSemaphoreTake(mLogLock, portMAX_DELAY);
+    // Packets received in the old state are reported before anything from the new one.
+    drainCaptures();
+    flushLogBatch();
+    if (mProbe.hasPending())
+    {
+        sendProbeReport(); // the partial window the test ended with
+    }
+    mProbe.reset();
+
+    // Payloads queued for the old state would otherwise go out on the next switch to TRANSMITTER.
+    mTxHead = 0;
+    mTxCount = 0;
+    mAggregate.size = 0;
+    mAggregateFrames = 0;
+    mRadio.discardPreloaded();
+    mRequeued = false;
+    stopRssiSampling();
+    mRssiCount = 0;
+
+    // Both ends start over on rung 0 when they change state.
+    abortPoll();
+    LinkAdapt decision;
+    if (mAdapter.enabled() && mAdapter.restart(millis(), decision))
+    {
+        applyRung(decision);
+        queueAdaptEvent(decision);
+    }
+
     if (newState == State_RECEIVER)
     {
         mRadio.setPacketReceivedAction(receivedISR);
@@ -285,4 +1520,16 @@ void RadioManager::setState(State newState)
     }
 
     state = newState;
+    xSemaphoreGive(mLogLock);
+    xSemaphoreGive(mLock);
+}
+
+/**
+ * @brief Puts the radio into standby.
+ */
+void RadioManager::standby()
+{
+    xSemaphoreTake(mLock, portMAX_DELAY);
+    mRadio.standby();
+    xSemaphoreGive(mLock);
 }
@@ -0,0 +1,164 @@
+/**
+ * @file SX1262Burst.cpp
+ * @brief SX1262 driver that stages the next payload in the idle half of the data buffer.
+ */
+
+#include "SX1262Burst.h"
+
+/**
+ * @brief Starts a transmission through the regular RadioLib path.
+ * @details RadioLib always writes the payload at offset 0, i.e. into the first half.
+ *          That also applies the image and sensitivity fixes, which persist for the
+ *          packets of the burst that follow as long as the modulation stays the same;
+ *          after a change the caller discards the staged payload and starts over here.
+ * @param data Pointer to the data to be transmitted.
+ * @param len Length of the data to be transmitted.
+ * @param addr Unused node address.
+ * @return RadioLib status code.
+ */
+int16_t SX1262Burst::startTransmit(const uint8_t *data, size_t len, uint8_t addr)
+{
+    if (len > HALF_SIZE)
+    {
+        // The payload spills into the second half and overwrites anything staged there.
+        mPreloaded = false;
+    }
+
+    int16_t state = SX1262::startTransmit(data, len, addr);
+    mOnAirHalf = 0;
+    mOnAirLength = len;
+    return state;
+}
+
+/**
+ * @brief Mirrors the packet parameters that SetPacketParams needs for a staged start.
+ * @param preambleLength LoRa preamble length in symbols.
+ * @param crc True if the LoRa CRC is enabled.
+ */
+void SX1262Burst::setPacketConfig(uint16_t preambleLength, bool crc)
+{
+    mPreambleLength = preambleLength;
+    mCrcType = crc ? RADIOLIB_SX126X_LORA_CRC_ON : RADIOLIB_SX126X_LORA_CRC_OFF;
+}
+
+/**
+ * @brief Sets the carrier frequency, calibrating the image rejection only when the band changes.
+ * @details The calibration is done for the whole band, so it stays valid while the
+ *          frequency moves within it. The chip holds one calibration at a time.
+ * @param freq Carrier frequency in MHz.
+ * @param calibrated Set to true if the image calibration had to be redone.
+ * @return RadioLib status code.
+ */
+int16_t SX1262Burst::tune(float freq, bool &calibrated)
+{
+    calibrated = false;
+    RADIOLIB_CHECK_RANGE(freq, 150.0f, 960.0f, RADIOLIB_ERR_INVALID_FREQUENCY);
+
+    uint8_t band[2];
+    imageBand(freq, band);
+    uint16_t key = (band[0] << 8) | band[1];
+    if (key != mImageBand)
+    {
+        // Forget the old band first, in case the calibration fails halfway.
+        mImageBand = 0;
+        int16_t state = calibrateImage(band);
+        RADIOLIB_ASSERT(state);
+        mImageBand = key;
+        calibrated = true;
+    }
+
+    return setFrequency(freq, true);
+}
+
+/**
+ * @brief Looks up the CalibrateImage arguments for a frequency, as RadioLib does.
+ * @details The Semtech presets cover the common ISM bands; anything else gets a
+ *          custom band of +-4 MHz around the frequency.
+ * @param freq Carrier frequency in MHz.
+ * @param band Set to the two CalibrateImage frequency bytes.
+ */
+void SX1262Burst::imageBand(float freq, uint8_t band[2])
+{
+    int mhz = static_cast<int>(freq);
+    if (mhz >= 902 && mhz <= 928)
+    {
+        band[0] = RADIOLIB_SX126X_CAL_IMG_902_MHZ_1;
+        band[1] = RADIOLIB_SX126X_CAL_IMG_902_MHZ_2;
+    }
+    else if (mhz >= 863 && mhz <= 870)
+    {
+        band[0] = RADIOLIB_SX126X_CAL_IMG_863_MHZ_1;
+        band[1] = RADIOLIB_SX126X_CAL_IMG_863_MHZ_2;
+    }
+    else if (mhz >= 779 && mhz <= 787)
+    {
+        band[0] = RADIOLIB_SX126X_CAL_IMG_779_MHZ_1;
+        band[1] = RADIOLIB_SX126X_CAL_IMG_779_MHZ_2;
+    }
+    else if (mhz >= 470 && mhz <= 510)
+    {
+        band[0] = RADIOLIB_SX126X_CAL_IMG_470_MHZ_1;
+        band[1] = RADIOLIB_SX126X_CAL_IMG_470_MHZ_2;
+    }
+    else if (mhz >= 430 && mhz <= 440)
+    {
+        band[0] = RADIOLIB_SX126X_CAL_IMG_430_MHZ_1;
+        band[1] = RADIOLIB_SX126X_CAL_IMG_430_MHZ_2;
+    }
+    else
+    {
+        // Same rounding as SX126x::calibrateImageRejection(freq - 4, freq + 4).
+        band[0] = static_cast<uint8_t>(floor((freq - 5.0f) / 4.0f));
+        band[1] = static_cast<uint8_t>(ceil((freq + 5.0f) / 4.0f));
+        band[0] = (band[0] % 2) ? band[0] : band[0] - 1;
+        band[1] = (band[1] % 2) ? band[1] : band[1] + 1;
+    }
+}
+
+/**
+ * @brief Writes a payload into the half of the data buffer not used by the packet on air.
+ * @param data Pointer to the payload.
+ * @param len Length of the payload, at most HALF_SIZE.
+ * @return RadioLib status code.
+ */
+int16_t SX1262Burst::preload(const uint8_t *data, size_t len)
+{
+    if (!canPreload(len))
+        return RADIOLIB_ERR_PACKET_TOO_LONG;
+
+    uint8_t offset = (mOnAirHalf ^ 1) * HALF_SIZE;
+    int16_t state = writeBuffer(const_cast<uint8_t *>(data), len, offset);
+    if (state == RADIOLIB_ERR_NONE)
+    {
+        mPreloadLength = len;
+        mPreloaded = true;
+    }
+    return state;
+}
+
+/**
+ * @brief Transmits the staged payload without writing it over SPI again.
+ * @details Must only be called once the previous packet has finished.
+ * @return RadioLib status code.
+ */
+int16_t SX1262Burst::startPreloaded()
+{
+    uint8_t half = mOnAirHalf ^ 1;
+    mPreloaded = false;
+
+    int16_t state = setBufferBaseAddress(half * HALF_SIZE, 0x00);
+    RADIOLIB_ASSERT(state);
+
+    state = setPacketParams(mPreambleLength, mCrcType, mPreloadLength, RADIOLIB_SX126X_LORA_HEADER_EXPLICIT, RADIOLIB_SX126X_LORA_IQ_STANDARD);
+    RADIOLIB_ASSERT(state);
+
+    state = clearIrqStatus();
+    RADIOLIB_ASSERT(state);
+
+    state = setTx(RADIOLIB_SX126X_TX_TIMEOUT_NONE);
+    RADIOLIB_ASSERT(state);
+
+    mOnAirHalf = half;
+    mOnAirLength = mPreloadLength;
+    return state;
+}
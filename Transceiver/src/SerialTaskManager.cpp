@@ -7,13 +7,19 @@
 
 /**
  * @brief Constructor for SerialTaskManager.
- * @param mBufferSize Size of the serial buffer.
+ * @details All frame buffers are allocated here, once; the receive path never touches the heap.
+ * @param mBufferSize Size of each frame slot.
  * @param mQueueSize Size of the task queue.
  */
 SerialTaskManager::SerialTaskManager(size_t mBufferSize, UBaseType_t mQueueSize)
-    : mTaskQueue(nullptr), mTaskHandle(nullptr),
-      mSerialBuffer(new uint8_t[mBufferSize]),
-      mBufferSize(mBufferSize), mBufferIndex(0), mQueueSize(mQueueSize) {}
+    : mTaskQueue(nullptr), mFreeQueue(nullptr), mTaskHandle(nullptr),
+      mBufferSize(mBufferSize), mQueueSize(mQueueSize),
+      mPoolSlots(static_cast<uint8_t>(std::min<UBaseType_t>(mQueueSize + 1, NO_SLOT))),
+      mSlab(new uint8_t[(mPoolSlots + 1) * mBufferSize]),
+      mTaskQueueStorage(new uint8_t[mQueueSize * sizeof(ProtoData)]),
+      mFreeQueueStorage(new uint8_t[mPoolSlots]),
+      mDecoder(&mSlab[mPoolSlots * mBufferSize], mBufferSize),
+      mMinFree(mPoolSlots) {}
 
 /**
  * @brief Destructor for SerialTaskManager.
@@ -28,7 +34,13 @@ SerialTaskManager::~SerialTaskManager()
     {
         vQueueDelete(mTaskQueue);
     }
-    delete[] mSerialBuffer;
+    if (mFreeQueue)
+    {
+        vQueueDelete(mFreeQueue);
+    }
+    delete[] mSlab;
+    delete[] mTaskQueueStorage;
+    delete[] mFreeQueueStorage;
 }
 
 /**
@@ -37,13 +49,20 @@ SerialTaskManager::~SerialTaskManager()
  */
 bool SerialTaskManager::begin()
 {
-    mTaskQueue = xQueueCreate(mQueueSize, sizeof(ProtoData *));
-    if (!mTaskQueue)
+    mTaskQueue = xQueueCreateStatic(mQueueSize, sizeof(ProtoData), mTaskQueueStorage, &mTaskQueueBuffer);
+    mFreeQueue = xQueueCreateStatic(mPoolSlots, sizeof(uint8_t), mFreeQueueStorage, &mFreeQueueBuffer);
+    if (!mTaskQueue || !mFreeQueue)
     {
         Serial.println("Failed to create task queue!");
         return false;
     }
 
+    for (uint8_t slot = 0; slot < mPoolSlots; ++slot)
+    {
+        xQueueSend(mFreeQueue, &slot, 0);
+    }
+    acquireRxSlot();
+
     BaseType_t result = xTaskCreatePinnedToCore(
         serialTask,
         "SerialTask",
@@ -59,9 +78,42 @@ bool SerialTaskManager::begin()
         return false;
     }
 
+#ifndef SERIAL_RX_POLLING
+    // Wake the task from the UART driver's event task on FIFO threshold or RX idle timeout.
+    Serial.setRxFIFOFull(RX_FIFO_THRESHOLD);
+    Serial.onReceive([this]()
+                     { xTaskNotifyGive(mTaskHandle); });
+#endif
+
     return true;
 }
 
+/**
+ * @brief Returns a frame slot to the pool once its message has been processed.
+ * @param slot Index of the slot received through the task queue.
+ */
+void SerialTaskManager::release(uint8_t slot)
+{
+    xQueueSend(mFreeQueue, &slot, 0);
+}
+
+/**
+ * @brief Fills the serial link counters of a Stats message.
+ * @param stats Reference to the Stats structure to be filled.
+ */
+void SerialTaskManager::fillStats(Stats &stats) const
+{
+    stats.rx_frames = mDecoder.frameCount();
+    stats.rx_crc_errors = mDecoder.crcErrorCount();
+    stats.rx_overflows = mDecoder.overflowCount();
+    stats.rx_malformed = mDecoder.malformedCount();
+    stats.pool_slots = mPoolSlots;
+    stats.pool_free = uxQueueMessagesWaiting(mFreeQueue);
+    stats.pool_min_free = mMinFree;
+    stats.pool_exhausted = mPoolExhausted;
+    stats.queue_full = mQueueFull;
+}
+
 /**
  * @brief Task function for processing serial data.
  * @param param Pointer to the SerialTaskManager instance.
@@ -71,8 +123,13 @@ void SerialTaskManager::serialTask(void *param)
     SerialTaskManager *instance = static_cast<SerialTaskManager *>(param);
     while (true)
     {
+#ifdef SERIAL_RX_POLLING
         instance->processSerialData();
         vTaskDelay(1 / portTICK_PERIOD_MS);
+#else
+        ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(RX_IDLE_WAKE_MS));
+        instance->processSerialData();
+#endif
     }
 }
 
@@ -81,67 +138,68 @@ void SerialTaskManager::serialTask(void *param)
  */
 void SerialTaskManager::processSerialData()
 {
-    while (Serial.available())
+    uint8_t chunk[RX_CHUNK];
+    size_t available;
+    while ((available = Serial.available()) > 0)
     {
-        mSerialBuffer[mBufferIndex++] = Serial.read();
-
-        // Handle buffer overflow
-        if (mBufferIndex >= mBufferSize)
+        size_t count = Serial.read(chunk, std::min(available, sizeof(chunk)));
+        uint32_t rxTimeUs = micros();
+        for (size_t i = 0; i < count; ++i)
         {
-            Serial.println("Buffer overflow, resetting!");
-            mBufferIndex = 0;
-            continue;
-        }
-
-        // Check for end marker
-        if (mBufferIndex >= END_LEN &&
-            memcmp(&mSerialBuffer[mBufferIndex - END_LEN], END_DELIMITER, END_LEN) == 0)
-        {
-
-            // Find start marker in entire buffer
-            uint8_t *start = static_cast<uint8_t *>(
-                memmem(mSerialBuffer, mBufferIndex, START_DELIMITER, START_LEN));
-
-            if (start)
+            if (mDecoder.push(chunk[i]))
             {
-                uint8_t *payloadStart = start + START_LEN;
-                uint8_t *payloadEnd = &mSerialBuffer[mBufferIndex - END_LEN];
-
-                if (payloadEnd > payloadStart)
-                {
-                    handleCompleteMessage(payloadStart, payloadEnd);
-                }
+                handleCompleteMessage(mDecoder.length(), rxTimeUs);
             }
-
-            mBufferIndex = 0; // Reset buffer after processing
         }
     }
 }
 
 /**
- * @brief Handles a complete message found in the serial buffer.
- * @param start Pointer to the start of the message payload.
- * @param end Pointer to the end of the message payload.
+ * @brief Hands a completed frame to the application and gives the decoder a fresh slot.
+ * @param length Length of the decoded message.
+ * @param rxTimeUs micros() when the final bytes of the frame were read.
  */
-void SerialTaskManager::handleCompleteMessage(uint8_t *start, uint8_t *end)
+void SerialTaskManager::handleCompleteMessage(size_t length, uint32_t rxTimeUs)
 {
-    size_t dataLength = end - start;
+    if (mRxSlot == NO_SLOT)
+    {
+        // Decoded into the scratch slot because the pool was empty.
+        mPoolExhausted++;
+        acquireRxSlot();
+        return;
+    }
 
-    if (uxQueueSpacesAvailable(mTaskQueue) == 0)
+    ProtoData message = {mRxSlot, length, rxTimeUs};
+    if (xQueueSend(mTaskQueue, &message, 0) != pdPASS)
     {
-        Serial.println("Queue full, dropping message");
+        // Keep the slot and let the next frame overwrite it.
+        mQueueFull++;
         return;
     }
 
-    ProtoData *message = new ProtoData;
-    message->buffer = new uint8_t[dataLength];
-    message->length = dataLength;
-    memcpy(message->buffer, start, dataLength);
+    acquireRxSlot();
+}
 
-    if (xQueueSend(mTaskQueue, &message, 0) != pdPASS)
+/**
+ * @brief Takes a free slot from the pool for the decoder, falling back to the scratch slot.
+ */
+void SerialTaskManager::acquireRxSlot()
+{
+    uint8_t slot;
+    if (xQueueReceive(mFreeQueue, &slot, 0) == pdPASS)
+    {
+        mRxSlot = slot;
+        mDecoder.setBuffer(&mSlab[slot * mBufferSize]);
+    }
+    else
+    {
+        mRxSlot = NO_SLOT;
+        mDecoder.setBuffer(&mSlab[mPoolSlots * mBufferSize]);
+    }
+
+    UBaseType_t free = uxQueueMessagesWaiting(mFreeQueue);
+    if (free < mMinFree)
     {
-        Serial.println("Failed to enqueue message");
-        delete[] message->buffer;
-        delete message;
+        mMinFree = free;
     }
 }
\ No newline at end of file
@@ -0,0 +1,270 @@
+/**
+ * @file SerialTxManager.cpp
+ * @brief Queues outbound packets in a ring buffer and writes them to the host from a dedicated task.
+ */
+
+#include "SerialTxManager.h"
+
+/**
+ * @brief Constructor for SerialTxManager.
+ * @param ringSize Size of the outbound ring buffer in bytes.
+ * @param maxPacketSize Largest encoded packet that will be queued.
+ * @param policy What to do when a packet does not fit in the ring buffer.
+ */
+SerialTxManager::SerialTxManager(size_t ringSize, size_t maxPacketSize, OverflowPolicy policy)
+    : mRing(nullptr), mTaskHandle(nullptr), mControlLock(nullptr), mRingSize(ringSize),
+      mMaxPacketSize(maxPacketSize), mPolicy(policy),
+      mRingStorage(new uint8_t[ringSize]),
+      mFrameBuffer(new uint8_t[FrameCodec::maxEncodedSize(maxPacketSize)]),
+      mFrameBufferSize(FrameCodec::maxEncodedSize(maxPacketSize)) {}
+
+/**
+ * @brief Destructor for SerialTxManager.
+ */
+SerialTxManager::~SerialTxManager()
+{
+    if (mTaskHandle)
+    {
+        vTaskDelete(mTaskHandle);
+    }
+    if (mRing)
+    {
+        vRingbufferDelete(mRing);
+    }
+    if (mControlLock)
+    {
+        vSemaphoreDelete(mControlLock);
+    }
+    delete[] mRingStorage;
+    delete[] mFrameBuffer;
+}
+
+/**
+ * @brief Creates the ring buffer and starts the transmit task.
+ * @return True if initialization is successful, false otherwise.
+ */
+bool SerialTxManager::begin()
+{
+    mControlLock = xSemaphoreCreateMutex();
+    if (!mControlLock)
+    {
+        Serial.println("Failed to create serial TX control lock!");
+        return false;
+    }
+
+    mRing = xRingbufferCreateStatic(mRingSize, RINGBUF_TYPE_NOSPLIT, mRingStorage, &mRingStruct);
+    if (!mRing)
+    {
+        Serial.println("Failed to create serial TX ring buffer!");
+        return false;
+    }
+    // A larger packet would pass the size check in sendPacket() and then never fit.
+    if (xRingbufferGetMaxItemSize(mRing) < HEADER_LEN + mMaxPacketSize)
+    {
+        Serial.printf("Serial TX ring of %u bytes cannot hold a %u byte packet!\n",
+                      static_cast<unsigned>(mRingSize), static_cast<unsigned>(mMaxPacketSize));
+        vRingbufferDelete(mRing);
+        mRing = nullptr;
+        return false;
+    }
+
+    BaseType_t result = xTaskCreatePinnedToCore(
+        txTask,
+        "SerialTxTask",
+        4096,
+        this,
+        1,
+        &mTaskHandle,
+        0);
+
+    if (result != pdPASS)
+    {
+        Serial.println("Failed to create serial TX task!");
+        return false;
+    }
+
+    return true;
+}
+
+/**
+ * @brief Clears and returns the packet the main loop builds its replies in.
+ * @details Replies are sent from deep in the main loop, often while the host packet being
+ *          answered is still being handled, so they share this member rather than each
+ *          putting a Packet on the loop stack. Main loop only, one reply at a time:
+ *          build it and pass it to sendPacket() before asking for the next.
+ * @return Reference to the zeroed reply packet.
+ */
+Packet &SerialTxManager::reply()
+{
+    memset(&mReply, 0, sizeof(mReply)); // Packet_init_zero, without a temporary on the stack
+    return mReply;
+}
+
+/**
+ * @brief Encodes a packet directly into the ring buffer for the transmit task to frame and write.
+ * @details The item records the framing in effect now, so a framing switch requested
+ *          after this call does not affect packets already queued.
+ * @param packet Reference to the Packet to be sent.
+ * @return True if the packet was queued, false if it was dropped.
+ */
+bool SerialTxManager::sendPacket(const Packet &packet)
+{
+    size_t encodedSize;
+    if (!pb_get_encoded_size(&encodedSize, Packet_fields, &packet) || encodedSize > mMaxPacketSize)
+    {
+        mDropped++;
+        return false;
+    }
+
+    void *item;
+    if (!acquire(&item, HEADER_LEN + encodedSize))
+    {
+        mDropped++;
+        return false;
+    }
+
+    uint8_t *bytes = static_cast<uint8_t *>(item);
+    pb_ostream_t stream = pb_ostream_from_buffer(bytes + HEADER_LEN, encodedSize);
+    bytes[0] = pb_encode(&stream, Packet_fields, &packet) ? FrameCodec::mode() : Framing_FRAMING_UNCHANGED;
+    xRingbufferSendComplete(mRing, item);
+
+    size_t used = mRingSize - xRingbufferGetCurFreeSize(mRing);
+    if (used > mHighWater)
+    {
+        mHighWater = used;
+    }
+    return true;
+}
+
+/**
+ * @brief Queues a baud rate change behind the packets already in the ring buffer.
+ * @details Everything queued before this call is written at the current rate; the
+ *          port is flushed and switched before anything queued after it. The change is
+ *          counted as pending first, so no producer evicts past it under OVERWRITE_OLDEST.
+ * @param baudRate The new baud rate.
+ * @return True if the change was queued.
+ */
+bool SerialTxManager::changeBaudRate(uint32_t baudRate)
+{
+    uint8_t item[HEADER_LEN + sizeof(baudRate)] = {CONTROL_BAUD_RATE};
+    memcpy(item + HEADER_LEN, &baudRate, sizeof(baudRate));
+
+    xSemaphoreTake(mControlLock, portMAX_DELAY);
+    mControlPending++;
+    xSemaphoreGive(mControlLock);
+
+    if (xRingbufferSend(mRing, item, sizeof(item), pdMS_TO_TICKS(CONTROL_SEND_TIMEOUT_MS)) == pdTRUE)
+        return true;
+
+    xSemaphoreTake(mControlLock, portMAX_DELAY);
+    mControlPending--;
+    xSemaphoreGive(mControlLock);
+    return false;
+}
+
+/**
+ * @brief Fills the serial transmit counters of a Stats message.
+ * @param stats Reference to the Stats structure to be filled.
+ */
+void SerialTxManager::fillStats(Stats &stats) const
+{
+    stats.tx_frames = mFrames;
+    stats.tx_dropped = mDropped;
+    stats.tx_overwritten = mOverwritten;
+    stats.tx_ring_size = mRingSize;
+    stats.tx_high_water = mHighWater;
+}
+
+/**
+ * @brief Reserves space for an item, applying the overflow policy if the ring buffer is full.
+ * @details Under OVERWRITE_OLDEST nothing is evicted while a baud rate change is pending:
+ *          the oldest item could be the change itself, and it must only be applied by the
+ *          TX task, after the packet ahead of it has been written. The new packet is
+ *          refused instead.
+ * @param item Receives a pointer to the reserved space.
+ * @param size Size of the item.
+ * @return True if space was reserved.
+ */
+bool SerialTxManager::acquire(void **item, size_t size)
+{
+    while (xRingbufferSendAcquire(mRing, item, size, 0) != pdTRUE)
+    {
+        if (mPolicy != OVERWRITE_OLDEST)
+            return false;
+
+        // Held from the check to the receive, so no change can become the oldest item in between.
+        xSemaphoreTake(mControlLock, portMAX_DELAY);
+        size_t oldestSize;
+        void *oldest = mControlPending ? nullptr : xRingbufferReceive(mRing, &oldestSize, 0);
+        xSemaphoreGive(mControlLock);
+        if (!oldest)
+            return false; // A baud rate change is pending, or the only queued item is being written out
+        vRingbufferReturnItem(mRing, oldest);
+        mOverwritten++;
+    }
+    return true;
+}
+
+/**
+ * @brief Task function draining the ring buffer to the serial port.
+ * @param param Pointer to the SerialTxManager instance.
+ */
+void SerialTxManager::txTask(void *param)
+{
+    SerialTxManager *instance = static_cast<SerialTxManager *>(param);
+    while (true)
+    {
+        size_t size;
+        uint8_t *item = static_cast<uint8_t *>(xRingbufferReceive(instance->mRing, &size, portMAX_DELAY));
+        if (item)
+        {
+            instance->writeItem(item, size);
+        }
+    }
+}
+
+/**
+ * @brief Frames a queued packet, releases its ring buffer space and writes it out.
+ * @details Called from the TX task only, which is also the only place control items are applied.
+ * @param item Pointer to the received ring buffer item.
+ * @param size Size of the item.
+ */
+void SerialTxManager::writeItem(uint8_t *item, size_t size)
+{
+    if (item[0] == CONTROL_BAUD_RATE)
+    {
+        applyControl(item);
+        vRingbufferReturnItem(mRing, item);
+
+        xSemaphoreTake(mControlLock, portMAX_DELAY);
+        mControlPending--;
+        xSemaphoreGive(mControlLock);
+        return;
+    }
+
+    Framing framing = static_cast<Framing>(item[0]);
+    size_t framed = 0;
+    if (framing != Framing_FRAMING_UNCHANGED)
+    {
+        framed = FrameCodec::encode(framing, item + HEADER_LEN, size - HEADER_LEN, mFrameBuffer, mFrameBufferSize);
+    }
+    vRingbufferReturnItem(mRing, item);
+
+    if (framed)
+    {
+        Serial.write(mFrameBuffer, framed);
+        mFrames++;
+    }
+}
+
+/**
+ * @brief Carries out a control item once every packet queued before it has been written.
+ * @param item Pointer to the control item.
+ */
+void SerialTxManager::applyControl(const uint8_t *item)
+{
+    uint32_t baudRate;
+    memcpy(&baudRate, item + HEADER_LEN, sizeof(baudRate));
+    Serial.flush();
+    Serial.updateBaudRate(baudRate);
+}
@@ -9,8 +9,9 @@
 /**
  * @brief Constructor for SettingsManager.
  * @param mRadio Reference to the SX1262 radio module.
+ * @param serialTx Reference to the SerialTxManager used for host output.
  */
-SettingsManager::SettingsManager(SX1262 &radio) : mRadio(radio)
+SettingsManager::SettingsManager(SX1262 &radio, SerialTxManager &serialTx) : mRadio(radio), mSerialTx(serialTx)
 {
     mConfig = Settings_init_zero;
 }
@@ -112,27 +113,52 @@ void SettingsManager::print() const
     Serial.println(mConfig.set_crc ? "True" : "False");
     Serial.print("Sync Word: ");
     Serial.println(mConfig.sync_word);
+    Serial.print("Batch Size: ");
+    Serial.println(mConfig.batch_size);
+    Serial.print("Batch Timeout (ms): ");
+    Serial.println(mConfig.batch_timeout_ms);
+    Serial.print("TX Overflow Policy: ");
+    Serial.println(mConfig.tx_overflow);
+    Serial.print("TX Burst: ");
+    Serial.println(mConfig.tx_burst ? "True" : "False");
+    Serial.print("Aggregate Bytes: ");
+    Serial.println(mConfig.aggregate_bytes);
+    Serial.print("Aggregate Timeout (ms): ");
+    Serial.println(mConfig.aggregate_timeout_ms);
+    Serial.print("RSSI Period (us): ");
+    Serial.println(mConfig.rssi_period_us);
+    Serial.print("RSSI Encoding: ");
+    Serial.println(mConfig.rssi_encoding);
+    Serial.print("Probe Window: ");
+    Serial.println(mConfig.probe_window);
+    Serial.print("Adaptation Ladder: ");
+    for (pb_size_t i = 0; i < mConfig.ladder_count; ++i)
+    {
+        const LinkRung &rung = mConfig.ladder[i];
+        Serial.printf("%sSF%ld BW%.1f CR4/%ld %ld dBm", i ? ", " : "", (long)rung.spreading_factor, rung.bandwidth, (long)rung.coding_rate, (long)rung.power);
+    }
+    Serial.println(mConfig.ladder_count ? "" : "None");
+    Serial.print("Adaptation Interval (ms): ");
+    Serial.println(mConfig.adapt_interval_ms);
+    Serial.print("Adaptation Target PER (ppm): ");
+    Serial.println(mConfig.adapt_target_per_ppm);
+    Serial.print("Adaptation Margin (dB): ");
+    Serial.println(mConfig.adapt_margin_db);
+    Serial.print("Adaptation Hysteresis (dB): ");
+    Serial.println(mConfig.adapt_hysteresis_db);
 }
 
 /**
- * @brief Sends the current settings as a protobuf packet over the serial connection.
+ * @brief Queues the current settings as a protobuf packet for the serial connection.
  */
 void SettingsManager::sendProto()
 {
-    Packet packet = Packet_init_zero;
+    Packet &packet = mSerialTx.reply();
     packet.type = PacketType_SETTINGS;
     packet.has_settings = true;
     packet.settings = mConfig;
 
-    uint8_t buffer[Packet_size];
-    pb_ostream_t stream = pb_ostream_from_buffer(buffer, sizeof(buffer));
-
-    if (pb_encode(&stream, Packet_fields, &packet))
-    {
-        Serial.write(START_DELIMITER, START_LEN);
-        Serial.write(buffer, stream.bytes_written);
-        Serial.write(END_DELIMITER, END_LEN);
-    }
+    mSerialTx.sendPacket(packet);
 }
 
 /**
@@ -149,6 +175,21 @@ void SettingsManager::createDefaults()
         .preamble = 8,
         .set_crc = true,
         .sync_word = 0xAB,
+        .batch_size = 0,
+        .batch_timeout_ms = 250,
+        .tx_overflow = TxOverflow_TX_OVERFLOW_BLOCK,
+        .tx_burst = false,
+        .aggregate_bytes = 0,
+        .aggregate_timeout_ms = 50,
+        .rssi_period_us = 0,
+        .rssi_encoding = RssiEncoding_RSSI_INT32,
+        .probe_window = 0,
+        .ladder_count = 0,
+        .ladder = {},
+        .adapt_interval_ms = 0,
+        .adapt_target_per_ppm = 10000,
+        .adapt_margin_db = 3.0,
+        .adapt_hysteresis_db = 2.0,
     };
 }
 
@@ -0,0 +1,299 @@
+/**
+ * @file TxScheduler.cpp
+ * @brief Transmits generated payloads at a fixed period without a host round-trip per packet.
+ */
+
+#include "TxScheduler.h"
+
+TxScheduler *TxScheduler::instance = nullptr;
+
+/**
+ * @brief Constructor for TxScheduler.
+ * @param radioMgr Reference to the RadioManager used to transmit.
+ * @param clock Reference to the ClockService that stamps probe payloads.
+ */
+TxScheduler::TxScheduler(RadioManager &radioMgr, ClockService &clock) : mRadioMgr(radioMgr), mClock(clock)
+{
+    instance = this;
+}
+
+/**
+ * @brief Creates the scheduler task.
+ * @return True if the task was created.
+ */
+bool TxScheduler::begin()
+{
+    mLock = xSemaphoreCreateMutex();
+    if (!mLock)
+        return false;
+
+    BaseType_t result = xTaskCreatePinnedToCore(
+        schedulerTask,
+        "SchedTask",
+        TASK_STACK_SIZE,
+        this,
+        TASK_PRIORITY,
+        &mTaskHandle,
+        TASK_CORE);
+
+    if (result != pdPASS)
+    {
+        Serial.println("Failed to create scheduler task!");
+        return false;
+    }
+
+    return true;
+}
+
+/**
+ * @brief Timer ISR, records the tick and wakes the scheduler task.
+ */
+void IRAM_ATTR TxScheduler::onTimer()
+{
+    if (!instance)
+        return;
+
+    portENTER_CRITICAL_ISR(&instance->mMux);
+    instance->mTicks++;
+    instance->mTickUs = micros();
+    portEXIT_CRITICAL_ISR(&instance->mMux);
+
+    BaseType_t woken = pdFALSE;
+    vTaskNotifyGiveFromISR(instance->mTaskHandle, &woken);
+    if (woken)
+    {
+        portYIELD_FROM_ISR();
+    }
+}
+
+/**
+ * @brief Scheduler task: serves each slot as soon as the timer ticks.
+ * @param param Pointer to the TxScheduler.
+ */
+void TxScheduler::schedulerTask(void *param)
+{
+    TxScheduler *self = static_cast<TxScheduler *>(param);
+    for (;;)
+    {
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+
+        xSemaphoreTake(self->mLock, portMAX_DELAY);
+        self->poll();
+        xSemaphoreGive(self->mLock);
+    }
+}
+
+/**
+ * @brief Starts transmitting on a schedule, replacing any schedule already running.
+ * @details The first slot is one period after this call. The statistics restart with it.
+ * @param schedule Reference to the schedule requested by the host.
+ * @return False if the schedule is invalid or the scheduler task is not running.
+ */
+bool TxScheduler::start(const Schedule &schedule)
+{
+    size_t minLength = schedule.pattern == PayloadPattern_PATTERN_PROBE ? ProbeTracker::HEADER_SIZE : 1;
+    if (!mTaskHandle || schedule.period_us < MIN_PERIOD_US || schedule.payload_length < minLength ||
+        schedule.payload_length > sizeof(mPayload))
+        return false;
+
+    xSemaphoreTake(mLock, portMAX_DELAY);
+    halt();
+    mSchedule = schedule;
+    mFinished = false;
+    mSent = 0;
+    mMissed = 0;
+    mDelay.reset();
+    mInterval.reset();
+    stage();
+
+    if (!mTimer)
+    {
+        mTimer = timerBegin(TIMER_NUMBER, TIMER_DIVIDER, true);
+        timerAttachInterrupt(mTimer, &TxScheduler::onTimer, true);
+    }
+
+    portENTER_CRITICAL(&mMux);
+    mTicks = 0;
+    portEXIT_CRITICAL(&mMux);
+    mHandledTicks = 0;
+
+    timerWrite(mTimer, 0);
+    timerAlarmWrite(mTimer, schedule.period_us, true);
+    timerAlarmEnable(mTimer);
+    mRunning = true;
+    xSemaphoreGive(mLock);
+    return true;
+}
+
+/**
+ * @brief Stops the schedule. The statistics are kept until the next start.
+ */
+void TxScheduler::stop()
+{
+    if (!mTaskHandle)
+        return;
+
+    xSemaphoreTake(mLock, portMAX_DELAY);
+    halt();
+    xSemaphoreGive(mLock);
+}
+
+/**
+ * @brief Stops the timer and drops the staged payload; the caller holds mLock.
+ */
+void TxScheduler::halt()
+{
+    if (!mRunning)
+        return;
+
+    timerAlarmDisable(mTimer);
+    mRunning = false;
+    mStaged = false;
+    mRadioMgr.discardPreloaded();
+}
+
+/**
+ * @brief Starts the transmission for a slot that has ticked and stages the next payload.
+ * @details Runs in the scheduler task with mLock held.
+ */
+void TxScheduler::poll()
+{
+    if (!mRunning)
+        return;
+
+    portENTER_CRITICAL(&mMux);
+    uint32_t ticks = mTicks;
+    uint32_t tickUs = mTickUs;
+    portEXIT_CRITICAL(&mMux);
+
+    if (ticks != mHandledTicks)
+    {
+        // Only the latest slot is served; any before it were overrun by the task.
+        mMissed += ticks - mHandledTicks - 1;
+        mHandledTicks = ticks;
+
+        if (mSchedule.pattern == PayloadPattern_PATTERN_PROBE)
+        {
+            ProbeTracker::writeHeader(mPayload, mSent, mClock.nowUs());
+        }
+
+        uint32_t startUs = 0;
+        if (mRadioMgr.startTransmission(mPayload, mLength, startUs))
+        {
+            mDelay.add(startUs - tickUs);
+            if (mSent++ == 0)
+            {
+                mFirstStartUs = startUs;
+            }
+            else
+            {
+                mInterval.add(startUs - mLastStartUs);
+            }
+            mLastStartUs = startUs;
+            mStaged = false;
+        }
+        else
+        {
+            mMissed++; // the previous packet was still on air
+        }
+
+        if (mSchedule.count != 0 && mSent >= mSchedule.count)
+        {
+            halt();
+            mFinished = true;
+            return;
+        }
+    }
+
+    if (!mStaged)
+    {
+        stage();
+    }
+}
+
+/**
+ * @brief Reports, once, that the schedule reached its count.
+ * @return True if the schedule finished since the last call.
+ */
+bool TxScheduler::takeFinished()
+{
+    if (!mTaskHandle)
+        return false;
+
+    xSemaphoreTake(mLock, portMAX_DELAY);
+    bool finished = mFinished;
+    mFinished = false;
+    xSemaphoreGive(mLock);
+    return finished;
+}
+
+/**
+ * @brief Fills the schedule counters of a Stats message.
+ * @param stats Reference to the Stats structure to be filled.
+ */
+void TxScheduler::fillStats(Stats &stats) const
+{
+    if (mLock)
+    {
+        xSemaphoreTake(mLock, portMAX_DELAY);
+    }
+    stats.sched_sent = mSent;
+    stats.sched_missed = mMissed;
+
+    uint32_t elapsedUs = mLastStartUs - mFirstStartUs;
+    stats.sched_rate_mhz = (mSent > 1 && elapsedUs) ? static_cast<uint32_t>((mSent - 1) * 1000000000ULL / elapsedUs) : 0;
+
+    stats.has_sched_delay = true;
+    mDelay.fill(stats.sched_delay);
+    stats.has_sched_interval = true;
+    mInterval.fill(stats.sched_interval);
+    if (mLock)
+    {
+        xSemaphoreGive(mLock);
+    }
+}
+
+/**
+ * @brief Generates the payload for the next slot and writes it into the radio.
+ * @details The first packet of a schedule is not staged, so it goes through the full
+ *          startTransmit() path that also sets up the RF switch and sensitivity fix.
+ *          Probes are never staged, since their send time is only known at the slot.
+ */
+void TxScheduler::stage()
+{
+    mLength = mSchedule.payload_length;
+    switch (mSchedule.pattern)
+    {
+    case PayloadPattern_PATTERN_RANDOM:
+        for (size_t i = 0; i < mLength; i += sizeof(uint32_t))
+        {
+            uint32_t word = esp_random();
+            memcpy(&mPayload[i], &word, std::min(sizeof(word), mLength - i));
+        }
+        break;
+    case PayloadPattern_PATTERN_ZEROS:
+        memset(mPayload, 0, mLength);
+        break;
+    case PayloadPattern_PATTERN_PROBE:
+        for (size_t i = 0; i < mLength; ++i)
+        {
+            mPayload[i] = static_cast<uint8_t>(i);
+        }
+        ProbeTracker::writeHeader(mPayload, mSent, 0); // stamped again when it is sent
+        break;
+    default:
+        // Packet number, then a ramp, so the receiver can spot both loss and corruption.
+        for (size_t i = 0; i < mLength; ++i)
+        {
+            mPayload[i] = static_cast<uint8_t>(mSent + i);
+        }
+        memcpy(mPayload, &mSent, std::min(sizeof(mSent), mLength));
+        break;
+    }
+
+    mStaged = true;
+    if (mSent > 0 && mSchedule.pattern != PayloadPattern_PATTERN_PROBE)
+    {
+        mRadioMgr.preloadTransmission(mPayload, mLength);
+    }
+}
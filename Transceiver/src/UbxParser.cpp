@@ -0,0 +1,143 @@
+/**
+ * @file UbxParser.cpp
+ * @brief Parses u-blox UBX frames one byte at a time and decodes NAV-PVT.
+ */
+
+#include "UbxParser.h"
+
+namespace
+{
+template <typename T>
+T readLe(const uint8_t *data)
+{
+    T value;
+    memcpy(&value, data, sizeof(value));
+    return value;
+}
+}
+
+/**
+ * @brief Takes the next byte from the GPS.
+ * @param c Byte received.
+ * @return True if it completed a frame with a valid checksum, now in payload().
+ */
+bool UbxParser::feed(uint8_t c)
+{
+    switch (mStep)
+    {
+    case WAIT_SYNC_1:
+        if (c == SYNC_1)
+            mStep = WAIT_SYNC_2;
+        break;
+    case WAIT_SYNC_2:
+        mStep = c == SYNC_2 ? READ_CLASS : (c == SYNC_1 ? WAIT_SYNC_2 : WAIT_SYNC_1);
+        break;
+    case READ_CLASS:
+        mCheckA = 0;
+        mCheckB = 0;
+        check(c);
+        mClass = c;
+        mStep = READ_ID;
+        break;
+    case READ_ID:
+        check(c);
+        mId = c;
+        mStep = READ_LENGTH_LOW;
+        break;
+    case READ_LENGTH_LOW:
+        check(c);
+        mLength = c;
+        mStep = READ_LENGTH_HIGH;
+        break;
+    case READ_LENGTH_HIGH:
+        check(c);
+        mLength |= static_cast<uint16_t>(c) << 8;
+        mReceived = 0;
+        // Frames too big to keep are dropped; the parser resyncs on the next sync bytes.
+        mStep = mLength > MAX_PAYLOAD ? WAIT_SYNC_1 : (mLength ? READ_PAYLOAD : READ_CHECKSUM_A);
+        break;
+    case READ_PAYLOAD:
+        check(c);
+        mPayload[mReceived++] = c;
+        if (mReceived == mLength)
+            mStep = READ_CHECKSUM_A;
+        break;
+    case READ_CHECKSUM_A:
+        mStep = c == mCheckA ? READ_CHECKSUM_B : WAIT_SYNC_1;
+        if (mStep == WAIT_SYNC_1)
+            mChecksumErrors++;
+        break;
+    case READ_CHECKSUM_B:
+        mStep = WAIT_SYNC_1;
+        if (c != mCheckB)
+        {
+            mChecksumErrors++;
+            return false;
+        }
+        mFrames++;
+        return true;
+    }
+    return false;
+}
+
+/**
+ * @brief Decodes the frame last completed as a NAV-PVT.
+ * @param pvt Set to the decoded solution.
+ * @return False if the frame is not a NAV-PVT.
+ */
+bool UbxParser::readNavPvt(NavPvt &pvt) const
+{
+    if (mClass != CLASS_NAV || mId != NAV_PVT || mLength < NAV_PVT_MIN_SIZE)
+        return false;
+
+    pvt.iTowMs = readLe<uint32_t>(&mPayload[0]);
+    pvt.year = readLe<uint16_t>(&mPayload[4]);
+    pvt.month = mPayload[6];
+    pvt.day = mPayload[7];
+    pvt.hour = mPayload[8];
+    pvt.minute = mPayload[9];
+    pvt.second = mPayload[10];
+    pvt.valid = mPayload[11];
+    pvt.nanoNs = readLe<int32_t>(&mPayload[16]);
+    pvt.fixType = mPayload[20];
+    pvt.flags = mPayload[21];
+    pvt.numSv = mPayload[23];
+    pvt.lonE7 = readLe<int32_t>(&mPayload[24]);
+    pvt.latE7 = readLe<int32_t>(&mPayload[28]);
+    pvt.hAccMm = readLe<uint32_t>(&mPayload[40]);
+    pvt.gSpeedMmS = readLe<int32_t>(&mPayload[60]);
+    pvt.headMotE5 = readLe<int32_t>(&mPayload[64]);
+    return true;
+}
+
+/**
+ * @brief Builds a UBX frame around a payload.
+ * @param msgClass Class of the frame.
+ * @param msgId Id of the frame.
+ * @param payload Pointer to the payload, may be null if length is 0.
+ * @param length Length of the payload.
+ * @param frame Pointer to a buffer of at least length + FRAME_OVERHEAD bytes.
+ * @return The frame length.
+ */
+size_t UbxParser::writeFrame(uint8_t msgClass, uint8_t msgId, const uint8_t *payload, uint16_t length, uint8_t *frame)
+{
+    frame[0] = SYNC_1;
+    frame[1] = SYNC_2;
+    frame[2] = msgClass;
+    frame[3] = msgId;
+    frame[4] = static_cast<uint8_t>(length);
+    frame[5] = static_cast<uint8_t>(length >> 8);
+    if (length)
+        memcpy(&frame[6], payload, length);
+
+    uint8_t checkA = 0;
+    uint8_t checkB = 0;
+    for (size_t i = 2; i < 6u + length; ++i)
+    {
+        checkA += frame[i];
+        checkB += checkA;
+    }
+    frame[6 + length] = checkA;
+    frame[7 + length] = checkB;
+    return length + FRAME_OVERHEAD;
+}
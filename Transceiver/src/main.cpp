@@ -15,13 +15,24 @@
 #include "ApplicationController.h"
 #include "RadioManager.h"
 #include "SerialTaskManager.h"
+#include "SX1262Burst.h"
+#include "SerialTxManager.h"
+#include "LinkManager.h"
+#include "TxScheduler.h"
+#include "GpsManager.h"
+#include "ClockService.h"
 
-SX1262 radio = new Module(RADIO_CS_PIN, RADIO_DIO1_PIN, RADIO_RST_PIN, RADIO_BUSY_PIN);
-SettingsManager settingsManager(radio);
+SX1262Burst radio = new Module(RADIO_CS_PIN, RADIO_DIO1_PIN, RADIO_RST_PIN, RADIO_BUSY_PIN);
+SerialTxManager serialTxManager(SerialTxManager::ringSizeFor(RadioManager::MAX_BATCH_PACKET_SIZE), RadioManager::MAX_BATCH_PACKET_SIZE, SerialTxManager::DROP_NEWEST);
+SettingsManager settingsManager(radio, serialTxManager);
 HardwareSerial &gpsSerial = Serial1;
-RadioManager radioManager(radio, gpsSerial);
+ClockService clockService;
+GpsManager gpsManager(gpsSerial, clockService);
+RadioManager radioManager(radio, gpsManager, clockService, serialTxManager);
 SerialTaskManager serialManager(1024, 20);
-ApplicationController appController(radioManager, serialManager, settingsManager);
+LinkManager linkManager(serialManager, serialTxManager);
+TxScheduler txScheduler(radioManager, clockService);
+ApplicationController appController(radioManager, serialManager, settingsManager, serialTxManager, linkManager, txScheduler, gpsManager);
 
 /**
  * @brief Initializes the hardware and application controller.
@@ -6,6 +6,9 @@
 #error Regenerate this file with the current version of nanopb generator.
 #endif
 
+PB_BIND(LinkRung, LinkRung, AUTO)
+
+
 PB_BIND(Settings, Settings, AUTO)
 
 
@@ -15,12 +18,39 @@ PB_BIND(Transmission, Transmission, 2)
 PB_BIND(Gps, Gps, AUTO)
 
 
+PB_BIND(RssiSummary, RssiSummary, AUTO)
+
+
 PB_BIND(Log, Log, 2)
 
 
+PB_BIND(LogBatch, LogBatch, AUTO)
+
+
+PB_BIND(Schedule, Schedule, AUTO)
+
+
 PB_BIND(Request, Request, AUTO)
 
 
+PB_BIND(LinkTest, LinkTest, 2)
+
+
+PB_BIND(Credit, Credit, AUTO)
+
+
+PB_BIND(Latency, Latency, AUTO)
+
+
+PB_BIND(Stats, Stats, 2)
+
+
+PB_BIND(ProbeReport, ProbeReport, AUTO)
+
+
+PB_BIND(LinkAdapt, LinkAdapt, AUTO)
+
+
 PB_BIND(Packet, Packet, 2)
 
 
@@ -29,6 +59,9 @@ PB_BIND(Packet, Packet, 2)
 
 
 
+
+
+
 #ifndef PB_CONVERT_DOUBLE_FLOAT
 /* On some platforms (such as AVR), double is really float.
  * To be able to encode/decode double on these platforms, you need.
@@ -9,7 +9,7 @@ from rich.columns import Columns
 from lora_tool.serial_comm import list_serial_ports, open_serial_port
 from lora_tool.lora_device import LoRaDevice
 from lora_tool.settings import update_settings
-from lora_tool.utils import parse_boolean_input
+from lora_tool.utils import parse_boolean_input, parse_ladder
 
 console = Console()
 
@@ -29,7 +29,10 @@ def display_menu_and_settings(lora_settings, gps_data):
     options_table.add_row("2", "Transmit Data")
     options_table.add_row("3", "View Received Data")
     options_table.add_row("4", "Update Settings")
-    options_table.add_row("5", "Quit")
+    options_table.add_row("5", "View Device Statistics")
+    options_table.add_row("6", "Negotiate Serial Baud Rate")
+    options_table.add_row("7", "Periodic Transmission")
+    options_table.add_row("8", "Quit")
 
     settings_table = Table(title="Current LoRa Settings")
     settings_table.add_column("Setting", justify="left")
@@ -76,7 +79,7 @@ def main_menu():
         current_settings = lora_device.lora_settings if lora_device else {}
         current_gps = lora_device.gps_data if lora_device else {}
         display_menu_and_settings(current_settings, current_gps)
-        choice = Prompt.ask("Choose an option", choices=["1", "2", "3", "4", "5"])
+        choice = Prompt.ask("Choose an option", choices=["1", "2", "3", "4", "5", "6", "7", "8"])
 
         if choice == "1":
             ports = list_serial_ports()
@@ -98,6 +101,11 @@ def main_menu():
             console.print(f"Selected port: {selected_port}", style="bold green")
             lora_device = LoRaDevice(ser)
             time.sleep(1)
+            if not lora_device.negotiate_framing():
+                console.print(
+                    "Device did not acknowledge COBS framing, using delimiters.",
+                    style="bold yellow",
+                )
             lora_device.update_status()
 
         elif choice == "2":
@@ -160,6 +168,70 @@ def main_menu():
                         )
                     )
                     sync_word = int(Prompt.ask("Enter syncword", default="0xAB"), 16)
+                    batch_size = int(
+                        Prompt.ask(
+                            "Enter reception log batch size (0 disables)", default="0"
+                        )
+                    )
+                    batch_timeout_ms = int(
+                        Prompt.ask("Enter batch timeout (ms)", default="250")
+                    )
+                    tx_overflow = packet_pb2.TxOverflow.Value(
+                        Prompt.ask(
+                            "TX queue overflow policy",
+                            choices=packet_pb2.TxOverflow.keys(),
+                            default="TX_OVERFLOW_BLOCK",
+                        )
+                    )
+                    tx_burst = parse_boolean_input(
+                        Prompt.ask(
+                            "Enable burst transmission [true/false]", default="false"
+                        )
+                    )
+                    aggregate_bytes = int(
+                        Prompt.ask(
+                            "Enter aggregated payload size (0 disables)", default="0"
+                        )
+                    )
+                    aggregate_timeout_ms = int(
+                        Prompt.ask("Enter aggregation timeout (ms)", default="50")
+                    )
+                    rssi_period_us = int(
+                        Prompt.ask(
+                            "Enter RSSI sample period (us, 0 for one symbol)",
+                            default="0",
+                        )
+                    )
+                    rssi_encoding = packet_pb2.RssiEncoding.Value(
+                        Prompt.ask(
+                            "RSSI trace encoding",
+                            choices=packet_pb2.RssiEncoding.keys(),
+                            default="RSSI_INT32",
+                        )
+                    )
+                    probe_window = int(
+                        Prompt.ask(
+                            "Enter probe report window (packets, 0 disables)",
+                            default="0",
+                        )
+                    )
+                    ladder = parse_ladder(
+                        Prompt.ask(
+                            "Enter link adaptation ladder as sf/bw/cr/power,... "
+                            "(most robust first, blank disables)",
+                            default="",
+                        )
+                    )
+                    adapt_interval_ms = (
+                        int(
+                            Prompt.ask(
+                                "Enter link adaptation poll interval (ms)",
+                                default="1000",
+                            )
+                        )
+                        if ladder
+                        else 0
+                    )
                     update_settings(
                         lora_device,
                         frequency,
@@ -170,6 +242,17 @@ def main_menu():
                         preamble,
                         set_crc,
                         sync_word,
+                        batch_size,
+                        batch_timeout_ms,
+                        tx_overflow,
+                        tx_burst,
+                        aggregate_bytes,
+                        aggregate_timeout_ms,
+                        rssi_period_us,
+                        rssi_encoding,
+                        probe_window,
+                        ladder,
+                        adapt_interval_ms,
                     )
                     console.print("Settings updated successfully.", style="bold green")
                     lora_device.update_status()
@@ -184,5 +267,90 @@ def main_menu():
                 console.input("Press Enter to return to the menu...")
 
         elif choice == "5":
+            if lora_device and lora_device.ser:
+                stats = lora_device.request_stats()
+                if stats is None:
+                    console.print("Device did not report statistics.", style="bold red")
+                else:
+                    stats_table = Table(title="Device Statistics")
+                    stats_table.add_column("Counter", justify="left")
+                    stats_table.add_column("Value", justify="right")
+                    for key, value in stats.items():
+                        stats_table.add_row(key, str(value))
+                    console.print(stats_table)
+            else:
+                console.print(
+                    "No serial port selected. Please select a port first.",
+                    style="bold red",
+                )
+            console.input("Press Enter to return to the menu...")
+
+        elif choice == "6":
+            if lora_device and lora_device.ser:
+                baud_rate = int(Prompt.ask("Enter baud rate", default="921600"))
+                console.print("Running link test...", style="bold yellow")
+                results = lora_device.negotiate_baud(baud_rate)
+                if results is None:
+                    console.print(
+                        f"Link test failed; staying at {lora_device.ser.baudrate} baud.",
+                        style="bold red",
+                    )
+                else:
+                    results_table = Table(title=f"Link Test at {baud_rate} baud")
+                    results_table.add_column("Result", justify="left")
+                    results_table.add_column("Value", justify="right")
+                    for key, value in results.items():
+                        results_table.add_row(key, str(value))
+                    console.print(results_table)
+            else:
+                console.print(
+                    "No serial port selected. Please select a port first.",
+                    style="bold red",
+                )
+            console.input("Press Enter to return to the menu...")
+
+        elif choice == "7":
+            if lora_device and lora_device.ser:
+                period_ms = float(Prompt.ask("Enter period (ms)", default="100"))
+                payload_length = int(
+                    Prompt.ask("Enter payload length (1-255)", default="10")
+                )
+                pattern = packet_pb2.PayloadPattern.Value(
+                    Prompt.ask(
+                        "Payload pattern",
+                        choices=packet_pb2.PayloadPattern.keys(),
+                        default="PATTERN_SEQUENCE",
+                    )
+                )
+                count = int(
+                    Prompt.ask("Enter packet count (0 runs until Ctrl+C)", default="100")
+                )
+                lora_device.change_state(packet_pb2.State.TRANSMITTER)
+                console.print("Transmitting... Press Ctrl+C to stop.", style="bold yellow")
+                stats = lora_device.run_schedule(
+                    int(period_ms * 1000), payload_length, pattern, count
+                )
+                lora_device.change_state(packet_pb2.State.STANDBY)
+                if stats is None:
+                    console.print("Device refused the schedule.", style="bold red")
+                else:
+                    results_table = Table(title="Periodic Transmission")
+                    results_table.add_column("Result", justify="left")
+                    results_table.add_column("Value", justify="right")
+                    for key, value in stats.items():
+                        if key.startswith("sched_"):
+                            results_table.add_row(key, str(value))
+                    interval = stats.get("sched_interval")
+                    if interval is not None:
+                        results_table.add_row("interval jitter (stddev us)", str(interval.stddev_us))
+                    console.print(results_table)
+            else:
+                console.print(
+                    "No serial port selected. Please select a port first.",
+                    style="bold red",
+                )
+            console.input("Press Enter to return to the menu...")
+
+        elif choice == "8":
             console.print("Exiting application.", style="bold yellow")
             break
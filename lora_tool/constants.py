@@ -2,3 +2,9 @@
 START_MARKER = b"<START>"
 # Marker indicating the end of a packet
 END_MARKER = b"<END>"
+# Delimiter surrounding COBS-encoded packets
+COBS_DELIMITER = b"\x00"
+# Seconds the device waits for a new baud rate to be committed before falling back
+BAUD_COMMIT_TIMEOUT = 3.0
+# Gps.fix_age_ms reported before the device's first GPS fix
+NO_FIX_AGE = 0xFFFFFFFF
@@ -1,6 +1,7 @@
 import os
 import pandas as pd
 from datetime import datetime
+import proto.packet_pb2 as packet_pb2
 
 
 def save_reception_data(reception_data, file_prefix):
@@ -20,3 +21,52 @@ def save_reception_data(reception_data, file_prefix):
 
     df = pd.DataFrame(reception_data)
     df.to_parquet(parquet_file, index=False)
+
+
+def align_logs(transmit_logs, reception_logs, guard_us=2000):
+    """
+    Pair each reception log with the transmission it received.
+
+    Both devices stamp their logs with a UTC clock disciplined by GNSS, and by
+    PPS where wired, so a reception's RX_DONE lies one short turnaround after
+    its transmission's end (tx_start_us + time_on_air_us). Each reception is
+    joined to the transmission ending nearest it, as long as the two are
+    within both clock errors plus guard_us. Logs stamped before a device had
+    GNSS time (CLOCK_LOCAL) are left out.
+
+    Args:
+        transmit_logs: DataFrame of transmission logs, as saved by transmit mode.
+        reception_logs: DataFrame of reception logs, as saved by receive mode.
+        guard_us: Allowance for the radio turnaround on top of the clock errors.
+
+    Returns:
+        DataFrame with one row per matched reception, the transmission's columns
+        prefixed "tx_" and the reception's "rx_", plus latency_us from the end of
+        the transmission to RX_DONE.
+    """
+    local = packet_pb2.ClockSource.CLOCK_LOCAL
+    tx = transmit_logs[transmit_logs["clock_source"] != local].add_prefix("tx_")
+    rx = reception_logs[reception_logs["clock_source"] != local].add_prefix("rx_")
+    if tx.empty or rx.empty:
+        return pd.DataFrame()
+
+    tx = tx.assign(
+        tx_end_us=(tx["tx_tx_start_us"] + tx["tx_time_on_air_us"]).astype("int64")
+    ).sort_values("tx_end_us")
+    rx = rx.assign(rx_done=rx["rx_rx_done_us"].astype("int64")).sort_values("rx_done")
+
+    tolerance = int(
+        tx["tx_clock_error_us"].max() + rx["rx_clock_error_us"].max() + guard_us
+    )
+    joined = pd.merge_asof(
+        rx,
+        tx,
+        left_on="rx_done",
+        right_on="tx_end_us",
+        direction="nearest",
+        tolerance=tolerance,
+    ).dropna(subset=["tx_end_us"])
+
+    joined["latency_us"] = joined["rx_done"] - joined["tx_end_us"].astype("int64")
+    allowed = joined["tx_clock_error_us"] + joined["rx_clock_error_us"] + guard_us
+    return joined[joined["latency_us"].abs() <= allowed].drop(columns="rx_done")
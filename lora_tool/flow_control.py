@@ -0,0 +1,117 @@
+import time
+
+
+class CreditWindow:
+    """
+    Host side of the credit-based flow control for TRANSMISSION packets.
+
+    The device answers every TRANSMISSION with an ACK carrying the number of
+    free slots in its TX queue, and sends an unsolicited ACK (sequence 0) when
+    a slot frees up after it advertised zero. Because ACKs arrive in the order
+    the device produced them, the credits in the latest ACK minus the
+    transmissions not yet answered is the number that can safely be sent.
+
+    A lost ACK or window update would leave the window shut for good, so once
+    it has been shut for ack_timeout seconds without an ACK, poll_due() hands
+    out a credit poll. The device answers it behind every ACK it sent before,
+    so any transmission sent earlier and still unanswered by then lost its ACK.
+    """
+
+    def __init__(self, initial_credits=1, ack_timeout=2.0, clock=time.monotonic):
+        """
+        Initialize the window.
+
+        Args:
+            initial_credits: Transmissions allowed before the first ACK arrives.
+            ack_timeout: Seconds the window may stay shut without an ACK
+                before a credit poll is due; longer than a packet's airtime,
+                since a full queue only frees a slot per transmission.
+            clock: Function returning the current time in seconds.
+        """
+        self.credits = initial_credits
+        self.capacity = initial_credits
+        self.unacked = 0
+        self.next_sequence = 1
+        self.accepted = 0
+        self.rejected = 0
+        self.ack_timeout = ack_timeout
+        self.clock = clock
+        self.last_ack = clock()
+        self.poll_sequence = None
+        self.stalls = 0
+        self.lost_acks = 0
+
+    def available(self):
+        """
+        Returns:
+            The number of transmissions that may be sent now.
+        """
+        return max(0, self.credits - self.unacked)
+
+    def on_sent(self):
+        """
+        Record a transmission being sent.
+
+        Returns:
+            The sequence number to put in the transmission.
+        """
+        if self.unacked == 0:
+            self.last_ack = self.clock()  # the deadline runs from the first unanswered one
+        sequence = self.next_sequence
+        self.next_sequence += 1
+        self.unacked += 1
+        return sequence
+
+    def poll_due(self):
+        """
+        Check whether the window has stalled and the device should be polled.
+
+        The window has stalled when nothing may be sent and no ACK has arrived
+        for ack_timeout seconds. Each call that reports a stall counts it in
+        stalls and restarts the timeout, so a lost poll is retried.
+
+        Returns:
+            The sequence number to send as Request.credit_poll, or None if the
+            window has not stalled.
+        """
+        if self.available() > 0 or self.clock() - self.last_ack < self.ack_timeout:
+            return None
+        self.stalls += 1
+        self.last_ack = self.clock()
+        self.poll_sequence = self.next_sequence
+        self.next_sequence += 1
+        return self.poll_sequence
+
+    def on_ack(self, packet):
+        """
+        Update the window from a received ACK packet.
+
+        Args:
+            packet: The received ACK packet.
+
+        Returns:
+            True if the ACK answered a transmission, False for a window update,
+            the answer to a credit poll or an ACK without credit information.
+        """
+        if not packet.HasField("credit"):
+            return False
+        credit = packet.credit
+        self.last_ack = self.clock()
+        self.credits = credit.credits
+        self.capacity = credit.capacity
+        if credit.sequence == 0:
+            return False
+        if credit.sequence == self.poll_sequence:
+            # Only the transmissions sent after the poll can still be answered.
+            sent_after = self.next_sequence - 1 - self.poll_sequence
+            self.lost_acks += max(0, self.unacked - sent_after)
+            self.unacked = min(self.unacked, sent_after)
+            self.poll_sequence = None
+            return False
+
+        self.unacked = max(0, self.unacked - 1)
+        if packet.ack:
+            self.accepted += 1
+        else:
+            self.rejected += 1
+        return True
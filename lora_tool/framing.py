@@ -0,0 +1,145 @@
+import binascii
+import proto.packet_pb2 as packet_pb2
+from lora_tool.constants import START_MARKER, END_MARKER, COBS_DELIMITER
+
+
+def crc16(data):
+    """
+    Compute the CRC-16/CCITT-FALSE checksum used by COBS frames.
+
+    Args:
+        data: The bytes to checksum.
+
+    Returns:
+        The 16-bit CRC.
+    """
+    return binascii.crc_hqx(data, 0xFFFF)
+
+
+def cobs_encode(data):
+    """
+    COBS-encode a byte string (without the trailing delimiter).
+
+    Args:
+        data: The bytes to encode.
+
+    Returns:
+        The encoded bytes, guaranteed to contain no zero bytes.
+    """
+    out = bytearray([0])
+    code_idx = 0
+    code = 1
+    for byte in data:
+        if byte == 0:
+            out[code_idx] = code
+            code_idx = len(out)
+            out.append(0)
+            code = 1
+            continue
+        out.append(byte)
+        code += 1
+        if code == 0xFF:
+            out[code_idx] = code
+            code_idx = len(out)
+            out.append(0)
+            code = 1
+    out[code_idx] = code
+    return bytes(out)
+
+
+def cobs_decode(data):
+    """
+    Decode a COBS-encoded byte string (without the trailing delimiter).
+
+    Args:
+        data: The encoded bytes.
+
+    Returns:
+        The decoded bytes, or None if the encoding is malformed.
+    """
+    out = bytearray()
+    idx = 0
+    while idx < len(data):
+        code = data[idx]
+        if code == 0 or idx + code > len(data):
+            return None
+        out += data[idx + 1 : idx + code]
+        idx += code
+        if code != 0xFF and idx < len(data):
+            out.append(0)
+    return bytes(out)
+
+
+def encode_frame(payload, framing=packet_pb2.FRAMING_DELIMITED):
+    """
+    Frame a serialized packet for the serial link.
+
+    Args:
+        payload: The serialized protobuf message.
+        framing: The framing mode to use.
+
+    Returns:
+        The framed bytes.
+    """
+    if framing == packet_pb2.FRAMING_COBS:
+        crc = crc16(payload)
+        encoded = cobs_encode(payload + bytes([crc & 0xFF, crc >> 8]))
+        return COBS_DELIMITER + encoded + COBS_DELIMITER
+    return START_MARKER + payload + END_MARKER
+
+
+class FrameDecoder:
+    """
+    Incremental decoder for frames received from the device in either framing mode.
+    """
+
+    def __init__(self, framing=packet_pb2.FRAMING_DELIMITED):
+        self.framing = framing
+        self.buffer = b""
+        self.crc_errors = 0
+
+    def feed(self, data):
+        """
+        Add received bytes and return any complete frame payloads.
+
+        Args:
+            data: Newly received bytes.
+
+        Returns:
+            A list of frame payloads, in order of arrival.
+        """
+        self.buffer += data
+        frames = []
+        while True:
+            if self.framing == packet_pb2.FRAMING_COBS:
+                # A legacy start marker right after a delimiter means the device fell
+                # back to delimited framing. Anywhere else it is COBS payload, which
+                # does not escape it.
+                if self.buffer.startswith(START_MARKER):
+                    self.framing = packet_pb2.FRAMING_DELIMITED
+                    continue
+                end = self.buffer.find(COBS_DELIMITER)
+                if end == -1:
+                    break
+                encoded = self.buffer[:end]
+                self.buffer = self.buffer[end + 1 :]
+                if not encoded:
+                    continue
+                decoded = cobs_decode(encoded)
+                if decoded is None or len(decoded) <= 2:
+                    continue
+                payload, crc = decoded[:-2], decoded[-2] | (decoded[-1] << 8)
+                if crc16(payload) != crc:
+                    self.crc_errors += 1
+                    continue
+                frames.append(payload)
+            else:
+                if START_MARKER not in self.buffer or END_MARKER not in self.buffer:
+                    break
+                start_idx = self.buffer.find(START_MARKER) + len(START_MARKER)
+                end_idx = self.buffer.find(END_MARKER, start_idx)
+                if end_idx == -1:
+                    break
+                frames.append(self.buffer[start_idx:end_idx])
+                self.buffer = self.buffer[end_idx + len(END_MARKER) :]
+        return frames
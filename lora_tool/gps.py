@@ -0,0 +1,75 @@
+def decode_position(gps):
+    """
+    Read the position of a Gps message in either encoding.
+
+    Firmware before the compact encoding sends latitude and longitude as
+    doubles; later firmware sends latitude_e7 and longitude_e7 in 1e-7 degrees
+    and leaves the doubles unset.
+
+    Args:
+        gps: The Gps message, with any batch delta already resolved.
+
+    Returns:
+        A (latitude, longitude) tuple in degrees.
+    """
+    if gps.latitude_e7 or gps.longitude_e7:
+        return gps.latitude_e7 * 1e-7, gps.longitude_e7 * 1e-7
+    return gps.latitude, gps.longitude
+
+
+def _wrap_int32(value):
+    return (value + 2**31) % 2**32 - 2**31
+
+
+def resolve_batch_gps(batch_gps, logs):
+    """
+    Give every log of a LogBatch an absolute position.
+
+    Firmware that delta-encodes positions marks each log's Gps with delta and
+    sends its latitude_e7/longitude_e7 as the change since the log before it,
+    the first relative to the batch's Gps; the sums wrap like int32. Older
+    firmware sends no Gps with the logs, which then share the batch's.
+
+    Args:
+        batch_gps: The gps of the LogBatch.
+        logs: The logs of the LogBatch, updated in place.
+    """
+    latitude_e7 = batch_gps.latitude_e7
+    longitude_e7 = batch_gps.longitude_e7
+    for log in logs:
+        if not log.HasField("gps"):
+            log.gps.CopyFrom(batch_gps)
+            continue
+        if not log.gps.delta:
+            latitude_e7 = log.gps.latitude_e7
+            longitude_e7 = log.gps.longitude_e7
+            continue
+        latitude_e7 = _wrap_int32(latitude_e7 + log.gps.latitude_e7)
+        longitude_e7 = _wrap_int32(longitude_e7 + log.gps.longitude_e7)
+        log.gps.latitude_e7 = latitude_e7
+        log.gps.longitude_e7 = longitude_e7
+        log.gps.delta = False
+
+
+def gps_columns(gps):
+    """
+    Flatten a Gps message into log columns.
+
+    Args:
+        gps: The Gps message, with any batch delta already resolved.
+
+    Returns:
+        A dict of latitude and longitude in degrees, satellites, fix_age_ms,
+        hdop, speed_m_s and course_deg. hdop is 0 where the module does not
+        report it.
+    """
+    latitude, longitude = decode_position(gps)
+    return {
+        "latitude": latitude,
+        "longitude": longitude,
+        "satellites": gps.satellites,
+        "fix_age_ms": gps.fix_age_ms,
+        "hdop": gps.hdop_centi / 100,
+        "speed_m_s": gps.speed_cm_s / 100,
+        "course_deg": gps.course_cdeg / 100,
+    }
@@ -1,13 +1,17 @@
-import struct
+import os
 import time
 import random
 import threading
+from collections import deque
 from datetime import datetime
 import proto.packet_pb2 as packet_pb2
 from rich.console import Console
-from rich.prompt import Prompt
-from lora_tool.constants import START_MARKER, END_MARKER
 from lora_tool.data_handler import save_reception_data
+from lora_tool.constants import BAUD_COMMIT_TIMEOUT, NO_FIX_AGE
+from lora_tool.flow_control import CreditWindow
+from lora_tool.framing import FrameDecoder, encode_frame
+from lora_tool.gps import decode_position, gps_columns, resolve_batch_gps
+from lora_tool.rssi import decode_rssi, summarize_rssi
 
 
 class LoRaDevice:
@@ -27,23 +31,324 @@ class LoRaDevice:
         self.lora_settings = {}
         self.gps_data = {}
         self.payload = 0
+        self.state = packet_pb2.State.STANDBY
+        self.framing = packet_pb2.FRAMING_DELIMITED
+        self.decoder = FrameDecoder(self.framing)
         self.lock = threading.Lock()
         self.console = Console()
 
-    def send_transmission(self, payload, delay):
+    def send_packet(self, packet):
+        """
+        Serialize, frame and write a packet using the current framing mode.
+
+        Args:
+            packet: The packet to send.
+        """
+        self.ser.write(encode_frame(packet.SerializeToString(), self.framing))
+
+    def negotiate_framing(self, framing=packet_pb2.FRAMING_COBS, timeout=1.0):
+        """
+        Ask the device to switch to a different framing mode.
+
+        The request and its ACK use the current framing; both ends switch once
+        the ACK has been received. If no ACK arrives the current mode is kept.
+
+        Args:
+            framing: The framing mode to switch to.
+            timeout: Seconds to wait for the ACK.
+
+        Returns:
+            True if the device acknowledged the new framing.
+        """
+        self.ser.reset_input_buffer()
+        request_pkt = self.new_request()
+        request_pkt.request.framing = framing
+        self.send_packet(request_pkt)
+
+        if self.wait_for_packet(packet_pb2.PacketType.ACK, timeout) is None:
+            return False
+        self.framing = framing
+        self.decoder = FrameDecoder(framing)
+        return True
+
+    def negotiate_baud(
+        self, baud_rate, count=200, size=200, max_error_rate=0.01, timeout=1.0
+    ):
+        """
+        Move the link to a higher baud rate, keeping it only if a self-test passes.
+
+        The device acknowledges at the old rate and switches provisionally. Both
+        ends then run a LINK_TEST echo exchange at the new rate; the change is
+        committed only if the share of lost or corrupted echoes stays within
+        max_error_rate. Otherwise the host returns to the old rate and waits for
+        the device to fall back on its own.
+
+        Args:
+            baud_rate: The baud rate to switch to.
+            count: Number of test frames to send.
+            size: Payload bytes per test frame.
+            max_error_rate: Largest tolerated fraction of failed echoes.
+            timeout: Seconds to wait for each ACK.
+
+        Returns:
+            The link test results if the new rate was committed, otherwise None.
+        """
+        old_baud = self.ser.baudrate
+        self.ser.reset_input_buffer()
+        request_pkt = self.new_request()
+        request_pkt.request.baud_rate = baud_rate
+        self.send_packet(request_pkt)
+
+        ack = self.wait_for_packet(packet_pb2.PacketType.ACK, timeout)
+        if ack is None or not ack.ack:
+            return None
+
+        # Give the device time to drain its TX queue and reprogram the UART.
+        time.sleep(0.05)
+        self.ser.baudrate = baud_rate
+        self.ser.reset_input_buffer()
+
+        results = self.run_link_test(count, size)
+        if results["errors"] <= count * max_error_rate:
+            commit_pkt = self.new_request()
+            commit_pkt.request.baud_commit = True
+            self.send_packet(commit_pkt)
+            if self.wait_for_packet(packet_pb2.PacketType.ACK, timeout) is not None:
+                return results
+
+        # Ask the device to go back now; if that is lost it falls back after the timeout.
+        revert_pkt = self.new_request()
+        revert_pkt.request.baud_rate = old_baud
+        self.send_packet(revert_pkt)
+        self.ser.baudrate = old_baud
+        time.sleep(BAUD_COMMIT_TIMEOUT)
+        self.ser.reset_input_buffer()
+        return None
+
+    def run_link_test(self, count=200, size=200, window=4, frame_timeout=0.5):
+        """
+        Measure serial integrity and throughput with LINK_TEST echoes.
+
+        Up to `window` frames are kept in flight. Each echo must return the
+        payload unchanged; echoes that are missing after frame_timeout or that
+        do not match count as errors.
+
+        Args:
+            count: Number of test frames to send.
+            size: Payload bytes per test frame (at most 255).
+            window: Number of frames in flight at once.
+            frame_timeout: Seconds before an unanswered frame is counted as lost.
+
+        Returns:
+            A dictionary with the echo count, error count, host-measured bytes/s
+            in both directions, and the device's own receive bytes/s and errors.
+        """
+        self.decoder = FrameDecoder(self.framing)
+        outstanding = {}
+        echoed = errors = next_sequence = 0
+        report = None
+
+        start = time.perf_counter()
+        while next_sequence < count or outstanding:
+            now = time.perf_counter()
+            while next_sequence < count and len(outstanding) < window:
+                test_pkt = packet_pb2.Packet()
+                test_pkt.type = packet_pb2.PacketType.LINK_TEST
+                test_pkt.link_test.sequence = next_sequence
+                test_pkt.link_test.payload = os.urandom(size)
+                self.send_packet(test_pkt)
+                outstanding[next_sequence] = (test_pkt.link_test.payload, now)
+                next_sequence += 1
+
+            for message in self.decoder.feed(self.ser.read(self.ser.in_waiting or 1)):
+                try:
+                    packets = self.parse_packets(message)
+                except Exception:
+                    continue
+                for packet in packets:
+                    if packet.type != packet_pb2.PacketType.LINK_TEST:
+                        continue
+                    sent = outstanding.pop(packet.link_test.sequence, None)
+                    if sent is None or sent[0] != packet.link_test.payload:
+                        errors += 1
+                        continue
+                    echoed += 1
+                    report = packet.link_test
+
+            for sequence, (_, sent_at) in list(outstanding.items()):
+                if now - sent_at > frame_timeout:
+                    del outstanding[sequence]
+                    errors += 1
+        elapsed = time.perf_counter() - start
+
+        return {
+            "frames": count,
+            "echoed": echoed,
+            "errors": errors,
+            "host_bytes_per_s": int(echoed * size / elapsed) if elapsed else 0,
+            "device_bytes_per_s": report.rx_bytes_per_s if report else 0,
+            "device_errors": report.rx_errors if report else 0,
+        }
+
+    def new_request(self):
+        """
+        Build a REQUEST packet that keeps the device in its current state.
+
+        Returns:
+            A REQUEST packet with stateChange set to the tracked state.
+        """
+        request_pkt = packet_pb2.Packet()
+        request_pkt.type = packet_pb2.PacketType.REQUEST
+        request_pkt.request.stateChange = self.state
+        return request_pkt
+
+    def wait_for_packet(self, packet_type, timeout=1.0):
+        """
+        Read from the serial port until a packet of the given type arrives.
+
+        Packets of other types received in the meantime are discarded.
+
+        Args:
+            packet_type: The PacketType to wait for.
+            timeout: Seconds to wait.
+
+        Returns:
+            The received packet, or None on timeout.
+        """
+        self.decoder = FrameDecoder(self.framing)
+        deadline = time.time() + timeout
+        while time.time() < deadline:
+            for message in self.decoder.feed(self.ser.read(self.ser.in_waiting or 1)):
+                try:
+                    packets = self.parse_packets(message)
+                except Exception:
+                    continue
+                for packet in packets:
+                    if packet.type == packet_type:
+                        return packet
+        return None
+
+    def parse_packets(self, message):
+        """
+        Parse a received frame, expanding a LOG_BATCH into individual LOG packets.
+
+        Each unpacked log gets an absolute GPS position, resolved from the batch's
+        position and the log's delta, so callers see the same packets whether or
+        not the device batches its reception logs.
+
+        Args:
+            message: The frame payload.
+
+        Returns:
+            A list of parsed packets.
+        """
+        packet = packet_pb2.Packet()
+        packet.ParseFromString(message)
+        if packet.type != packet_pb2.PacketType.LOG_BATCH:
+            return [packet]
+
+        packets = []
+        resolve_batch_gps(packet.log_batch.gps, packet.log_batch.logs)
+        for log in packet.log_batch.logs:
+            unpacked = packet_pb2.Packet()
+            unpacked.type = packet_pb2.PacketType.LOG
+            unpacked.log.CopyFrom(log)
+            packets.append(unpacked)
+        return packets
+
+    def request_stats(self, timeout=1.0):
+        """
+        Request the device's serial link and buffer counters.
+
+        Args:
+            timeout: Seconds to wait for the reply.
+
+        Returns:
+            A dictionary of counter names to values, or None on timeout.
+        """
+        request_pkt = self.new_request()
+        request_pkt.request.stats = True
+        self.send_packet(request_pkt)
+
+        packet = self.wait_for_packet(packet_pb2.PacketType.STATS, timeout)
+        if packet is None:
+            return None
+        return {
+            field.name: value for field, value in packet.stats.ListFields()
+        }
+
+    def run_schedule(
+        self,
+        period_us,
+        payload_length,
+        pattern=packet_pb2.PATTERN_SEQUENCE,
+        count=100,
+        timeout=1.0,
+    ):
+        """
+        Have the device transmit generated payloads on its own hardware timer.
+
+        The device must be in TRANSMITTER state. It sends STATS by itself once
+        `count` packets are out; Ctrl+C stops the schedule early.
+
+        Args:
+            period_us: Time between packets in microseconds.
+            payload_length: Payload bytes per packet (1-255).
+            pattern: PayloadPattern used to fill the payloads.
+            count: Number of packets to send, or 0 to run until interrupted.
+            timeout: Seconds to wait for the ACK.
+
+        Returns:
+            The device statistics after the run, or None if the schedule was refused.
+        """
+        request_pkt = self.new_request()
+        request_pkt.request.schedule.period_us = period_us
+        request_pkt.request.schedule.payload_length = payload_length
+        request_pkt.request.schedule.pattern = pattern
+        request_pkt.request.schedule.count = count
+        self.send_packet(request_pkt)
+
+        ack = self.wait_for_packet(packet_pb2.PacketType.ACK, timeout)
+        if ack is None or not ack.ack:
+            return None
+
+        try:
+            if count:
+                # Allow for slots missed while the previous packet was still on air.
+                packet = self.wait_for_packet(
+                    packet_pb2.PacketType.STATS, count * period_us * 2e-6 + timeout
+                )
+                if packet is not None:
+                    return {
+                        field.name: value for field, value in packet.stats.ListFields()
+                    }
+            else:
+                while True:
+                    time.sleep(1)
+        except KeyboardInterrupt:
+            pass
+
+        stop_pkt = self.new_request()
+        stop_pkt.request.schedule.period_us = 0
+        self.send_packet(stop_pkt)
+        self.wait_for_packet(packet_pb2.PacketType.ACK, timeout)
+        return self.request_stats(timeout)
+
+    def send_transmission(self, payload, delay=0, sequence=0):
         """
         Build and send a transmission packet containing the payload.
 
         Args:
             payload: The data payload to send.
+            delay: Seconds to sleep after sending.
+            sequence: Sequence number echoed back in the device's ACK.
         """
         if self.ser:
             transmission_packet = packet_pb2.Packet()
             transmission_packet.type = packet_pb2.PacketType.TRANSMISSION
             transmission_packet.transmission.payload = payload
-            serialized = transmission_packet.SerializeToString()
-            framed = START_MARKER + serialized + END_MARKER
-            self.ser.write(framed)
+            transmission_packet.transmission.sequence = sequence
+            self.send_packet(transmission_packet)
 
             self.transmit_count += 1
             # self.console.print(
@@ -52,6 +357,17 @@ class LoRaDevice:
             # )
             time.sleep(delay)
 
+    def send_credit_poll(self, sequence):
+        """
+        Ask the device for an ACK carrying its current TX queue credits.
+
+        Args:
+            sequence: Poll number from CreditWindow.poll_due(), echoed in the ACK.
+        """
+        request_pkt = self.new_request()
+        request_pkt.request.credit_poll = sequence
+        self.send_packet(request_pkt)
+
     def update_lora_settings(self, packet):
         """
         Update the stored settings from a received SETTINGS packet.
@@ -69,6 +385,24 @@ class LoRaDevice:
             "Preamble": settings.preamble,
             "CRC Enabled": settings.set_crc,
             "Sync Word": hex(settings.sync_word),
+            "Batch Size": settings.batch_size,
+            "Batch Timeout (ms)": settings.batch_timeout_ms,
+            "TX Overflow": packet_pb2.TxOverflow.Name(settings.tx_overflow),
+            "TX Burst": settings.tx_burst,
+            "Aggregate Bytes": settings.aggregate_bytes,
+            "Aggregate Timeout (ms)": settings.aggregate_timeout_ms,
+            "RSSI Period (us)": settings.rssi_period_us,
+            "RSSI Encoding": packet_pb2.RssiEncoding.Name(settings.rssi_encoding),
+            "Probe Window": settings.probe_window,
+            "Link Ladder": ", ".join(
+                f"SF{r.spreading_factor}/{r.bandwidth:g}/4:{r.coding_rate}/{r.power}dBm"
+                for r in settings.ladder
+            )
+            or "off",
+            "Adapt Interval (ms)": settings.adapt_interval_ms,
+            "Adapt Target PER (ppm)": settings.adapt_target_per_ppm,
+            "Adapt Margin (dB)": settings.adapt_margin_db,
+            "Adapt Hysteresis (dB)": settings.adapt_hysteresis_db,
         }
 
     def update_status(self):
@@ -90,10 +424,15 @@ class LoRaDevice:
                 packet.type == packet_pb2.PacketType.GPS and not status_received["gps"]
             ):
                 gps = packet.gps
+                latitude, longitude = decode_position(gps)
                 self.gps_data = {
-                    "Latitude": gps.latitude,
-                    "Longitude": gps.longitude,
+                    "Latitude": latitude,
+                    "Longitude": longitude,
                     "Satellites": gps.satellites,
+                    "HDOP": gps.hdop_centi / 100 if gps.hdop_centi else "unknown",
+                    "Fix Age (ms)": (
+                        "no fix" if gps.fix_age_ms == NO_FIX_AGE else gps.fix_age_ms
+                    ),
                 }
                 status_received["gps"] = True
             if all(status_received.values()):
@@ -102,15 +441,12 @@ class LoRaDevice:
         self.console.print("Requesting settings and GPS status...", style="bold yellow")
         # Send combined requests for settings and GPS
         for req_type in [("settings", True), ("gps", True)]:
-            request_pkt = packet_pb2.Packet()
-            request_pkt.type = packet_pb2.PacketType.REQUEST
+            request_pkt = self.new_request()
             if req_type[0] == "settings":
                 request_pkt.request.settings = True
             else:
                 request_pkt.request.gps = True
-            serialized = request_pkt.SerializeToString()
-            framed = START_MARKER + serialized + END_MARKER
-            self.ser.write(framed)
+            self.send_packet(request_pkt)
         try:
             self.process_serial_packets(callback)
         except KeyboardInterrupt:
@@ -118,38 +454,35 @@ class LoRaDevice:
                 "Received both settings and GPS status.", style="bold green"
             )
 
-    def process_serial_packets(self, callback, exit_on_condition=False):
+    def process_serial_packets(self, callback, exit_on_condition=False, idle=None):
         """
         Generic function to process incoming serial data.
 
-        This method reads data from the serial bus, parses complete packets based on the
-        defined START_MARKER and END_MARKER, and then calls the provided callback with
-        each successfully parsed packet.
+        This method reads data from the serial bus, extracts complete frames in the
+        negotiated framing mode, and then calls the provided callback with each
+        successfully parsed packet.
 
         Args:
             callback: A function that accepts a single parameter (the parsed packet).
             exit_on_condition: If True, the function exits after the callback is called.
+            idle: Optional function without parameters called on every pass of
+                the read loop, e.g. to check a deadline.
         """
-        buffer = b""
+        self.decoder = FrameDecoder(self.framing)
         try:
             while True:
+                if idle is not None:
+                    idle()
                 if self.ser.in_waiting > 0:
-                    buffer += self.ser.read(self.ser.in_waiting)
                     # Process all complete packets in the buffer
-                    while START_MARKER in buffer and END_MARKER in buffer:
-                        start_idx = buffer.find(START_MARKER) + len(START_MARKER)
-                        end_idx = buffer.find(END_MARKER)
-                        message = buffer[start_idx:end_idx]
-                        buffer = buffer[end_idx + len(END_MARKER) :]
-
-                        received_packet = packet_pb2.Packet()
+                    for message in self.decoder.feed(self.ser.read(self.ser.in_waiting)):
                         try:
-                            received_packet.ParseFromString(message)
-                            callback(received_packet)
-                            if exit_on_condition:
-                                return
+                            for received_packet in self.parse_packets(message):
+                                callback(received_packet)
+                                if exit_on_condition:
+                                    return
                         except Exception as e:
-                            self.console.print(received_packet)
+                            self.console.print(message)
                             self.console.print(
                                 f"Failed to decode message: {e}", style="bold red"
                             )
@@ -165,12 +498,34 @@ class LoRaDevice:
             "Checking for received data... Press Ctrl+C to stop.", style="bold yellow"
         )
         reception_data_list = []
+        probe_reports = []
+        link_events = []
         file_prefix = input("Enter a name for the Parquet file: ")
 
         # Reset counters
         self.receive_count = self.erroneous_count = self.received_total = 0
 
         def data_callback(packet):
+            if packet.type == packet_pb2.PacketType.PROBE_REPORT:
+                report = packet.probe_report
+                self.console.print(
+                    f"\nWindow {report.window}: {report.received}/{report.expected} received, "
+                    f"PER {report.per_ppm / 1e4:.2f}% | dup {report.duplicates} | "
+                    f"reordered {report.reordered} | longest burst {report.burst_max} | "
+                    f"latency p50/p90/p99 {report.latency_p50_us}/{report.latency_p90_us}/"
+                    f"{report.latency_p99_us} us",
+                    style="bold cyan",
+                )
+                row = {"timestamp": datetime.utcnow().isoformat()}
+                for field in report.DESCRIPTOR.fields:
+                    value = getattr(report, field.name)
+                    row[field.name] = list(value) if field.name == "burst_hist" else value
+                probe_reports.append(row)
+                return
+            if packet.type == packet_pb2.PacketType.LINK_ADAPT:
+                link_events.append(self.print_link_adapt(packet.link_adapt))
+                return
+
             self.received_total += 1
             if packet.log.crc_error:
                 self.erroneous_count += 1
@@ -194,19 +549,25 @@ class LoRaDevice:
                     "timestamp": datetime.utcnow().isoformat(),
                     "crc_error": packet.log.crc_error,
                     "general_error": packet.log.general_error,
-                    "latitude": packet.log.gps.latitude,
-                    "longitude": packet.log.gps.longitude,
-                    "satellites": packet.log.gps.satellites,
-                    "rssi_log": list(
-                        struct.unpack(
-                            f"{len(packet.log.rssi_log) // 4}i",
-                            packet.log.rssi_log,
-                        )
+                    **gps_columns(packet.log.gps),
+                    "rssi_log": decode_rssi(
+                        packet.log.rssi_log, packet.log.rssi_encoding
                     ),
+                    "rssi_period_us": packet.log.rssi_period_us,
+                    "rssi_missed": packet.log.rssi_missed,
                     "rssi_avg": packet.log.rssi_avg,
                     "snr": packet.log.snr,
                     "payload": packet.log.payload,
+                    "frame_index": packet.log.frame_index,
+                    "frame_count": packet.log.frame_count,
+                    "header_valid_us": packet.log.header_valid_us,
+                    "rx_done_us": packet.log.rx_done_us,
+                    "time_on_air_us": packet.log.time_on_air_us,
+                    "clock_source": packet.log.clock_source,
+                    "clock_error_us": packet.log.clock_error_us,
                 }
+                if packet.log.HasField("rssi_summary"):
+                    reception_data.update(summarize_rssi(packet.log.rssi_summary))
                 reception_data_list.append(reception_data)
 
         try:
@@ -216,6 +577,47 @@ class LoRaDevice:
             self.console.print("\nReception monitoring stopped.", style="bold yellow")
             if reception_data_list:
                 save_reception_data(reception_data_list, file_prefix)
+            if probe_reports:
+                save_reception_data(probe_reports, f"{file_prefix}_probe")
+            if link_events:
+                save_reception_data(link_events, f"{file_prefix}_link")
+
+    def print_link_adapt(self, event):
+        """
+        Print a link adaptation decision and return it as a row for saving.
+
+        Args:
+            event: The LinkAdapt message of a LINK_ADAPT packet.
+
+        Returns:
+            A dict with the decision's fields and the rung's settings.
+        """
+        reason = packet_pb2.AdaptReason.Name(event.reason)
+        rung = event.settings
+        self.console.print(
+            f"\nLink {'switched' if event.applied else 'proposed'} rung "
+            f"{event.previous_rung} -> {event.rung} ({reason}): SF{rung.spreading_factor} "
+            f"BW{rung.bandwidth:g} CR4/{rung.coding_rate} {rung.power} dBm | "
+            f"{event.received}/{event.sent} received, PER {event.per_ppm / 1e4:.2f}% | "
+            f"SNR {event.snr:.1f} dB, margin {event.margin_db:.1f} dB",
+            style="bold magenta",
+        )
+        return {
+            "timestamp": datetime.utcnow().isoformat(),
+            "rung": event.rung,
+            "previous_rung": event.previous_rung,
+            "reason": reason,
+            "applied": event.applied,
+            "sent": event.sent,
+            "received": event.received,
+            "per_ppm": event.per_ppm,
+            "snr": event.snr,
+            "margin_db": event.margin_db,
+            "spreading_factor": rung.spreading_factor,
+            "bandwidth": rung.bandwidth,
+            "coding_rate": rung.coding_rate,
+            "power": rung.power,
+        }
 
     def check_transmit_log(self, num_bytes):
         """
@@ -223,6 +625,10 @@ class LoRaDevice:
         Each transmit log is printed to the console and stored in self.transmit_logs.
         The process runs continuously until interrupted by the user.
 
+        Transmissions are pipelined: as many are kept in flight as the device
+        advertises free TX queue slots in its ACKs, so the radio is never left
+        idle waiting for the host and no payload is sent that it cannot queue.
+
         Args:
             num_bytes: The number of random bytes to send in each transmission.
         """
@@ -230,51 +636,91 @@ class LoRaDevice:
             "Starting transmit log monitoring... Press Ctrl+C to stop.",
             style="bold yellow",
         )
-        delay = float(
-            Prompt.ask(
-                "Enter the delay between transmissions (in seconds): ", default="1.0"
-            )
-        )
         file_prefix = input(
             "Enter a name for the Parquet file (for saving transmit logs): "
         )
         transmit_logs = []
+        link_events = []
         self.transmit_count = self.erroneous_count = 0
+        window = CreditWindow()
+        in_flight = {}  # sequence -> payload, waiting for the device's ACK
+        queued = deque()  # accepted payloads, in the order the radio will send them
 
-        # Send the first transmission
-        self.payload = bytes([random.randint(0, 255) for _ in range(num_bytes)])
-        self.send_transmission(self.payload, delay)
+        def fill_window():
+            while window.available() > 0:
+                payload = bytes([random.randint(0, 255) for _ in range(num_bytes)])
+                sequence = window.on_sent()
+                in_flight[sequence] = payload
+                self.send_transmission(payload, sequence=sequence)
+
+        def check_window():
+            sequence = window.poll_due()
+            if sequence is None:
+                return
+            self.console.print(
+                f"\nNo ACK for {window.ack_timeout} s with the window shut "
+                f"(stall {window.stalls}, {window.lost_acks} ACKs lost so far); polling for credits",
+                style="bold red",
+            )
+            self.send_credit_poll(sequence)
 
         def transmit_log_callback(packet):
+            if packet.type == packet_pb2.PacketType.ACK:
+                if window.on_ack(packet):
+                    payload = in_flight.pop(packet.credit.sequence, None)
+                    # Payloads evicted under TX_OVERFLOW_DROP_OLDEST will never be sent.
+                    for _ in range(min(packet.credit.evicted, len(queued))):
+                        queued.popleft()
+                    if packet.ack and payload is not None:
+                        queued.append(payload)
+                fill_window()
+                return
+            if packet.type == packet_pb2.PacketType.LINK_ADAPT:
+                link_events.append(self.print_link_adapt(packet.link_adapt))
+                return
+
             # Check the log fields (using the 'log' field instead of 'reception')
             if packet.log.general_error:
                 self.erroneous_count += 1
 
             # Append the log entry for future reference.
             if packet.HasField("log"):
+                # A packed transmission carries several of the queued payloads.
+                frames = max(1, packet.log.frame_count)
+                self.payload = b"".join(
+                    queued.popleft() for _ in range(min(frames, len(queued)))
+                )
+                latitude, longitude = decode_position(packet.log.gps)
                 log_entry = {
                     "timestamp": datetime.utcnow().isoformat(),
                     "general_error": packet.log.general_error,
-                    "latitude": packet.log.gps.latitude,
-                    "longitude": packet.log.gps.longitude,
+                    "latitude": latitude,
+                    "longitude": longitude,
                     "num_satellites": packet.log.gps.satellites,
+                    "fix_age_ms": packet.log.gps.fix_age_ms,
                     "payload": self.payload,
+                    "tx_queued": packet.log.tx_queued,
+                    "tx_rejected": packet.log.tx_rejected,
+                    "tx_dropped_newest": packet.log.tx_dropped_newest,
+                    "tx_dropped_oldest": packet.log.tx_dropped_oldest,
+                    "frame_count": frames,
+                    "tx_start_us": packet.log.tx_start_us,
+                    "prev_tx_done_us": packet.log.prev_tx_done_us,
+                    "time_on_air_us": packet.log.time_on_air_us,
+                    "clock_source": packet.log.clock_source,
+                    "clock_error_us": packet.log.clock_error_us,
                 }
                 transmit_logs.append(log_entry)
                 self.console.print(
-                    f"Total: {self.transmit_count} | Success: {self.receive_count} | "
-                    f"Errors: {self.erroneous_count}",
+                    f"Total: {self.transmit_count} | Accepted: {window.accepted} | "
+                    f"Rejected: {window.rejected} | Errors: {self.erroneous_count}",
                     end="\r",
                     style="bold green",
                 )
 
-            # Immediately send a new transmission with a fresh random payload.
-            self.payload = bytes([random.randint(0, 255) for _ in range(num_bytes)])
-            self.send_transmission(self.payload, delay)
-
         try:
-            # self.ser.reset_input_buffer()  # Clears the input buffer
-            self.process_serial_packets(transmit_log_callback)
+            fill_window()
+            self.process_serial_packets(transmit_log_callback, idle=check_window)
         except KeyboardInterrupt:
             self.console.print(
                 "\nTransmit log monitoring stopped.", style="bold yellow"
@@ -282,6 +728,8 @@ class LoRaDevice:
             # Save the collected transmit logs if any.
             if transmit_logs:
                 save_reception_data(transmit_logs, file_prefix)
+            if link_events:
+                save_reception_data(link_events, f"{file_prefix}_link")
 
     def change_state(self, state):
         """
@@ -294,6 +742,5 @@ class LoRaDevice:
             stateChange_request = packet_pb2.Packet()
             stateChange_request.type = packet_pb2.PacketType.REQUEST
             stateChange_request.request.stateChange = state
-            serialized_request = stateChange_request.SerializeToString()
-            framed_request = START_MARKER + serialized_request + END_MARKER
-            self.ser.write(framed_request)
+            self.send_packet(stateChange_request)
+            self.state = state
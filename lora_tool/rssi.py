@@ -0,0 +1,58 @@
+import struct
+import proto.packet_pb2 as packet_pb2
+
+
+def decode_rssi(data, encoding=packet_pb2.RSSI_INT32):
+    """
+    Decode the instantaneous RSSI trace of a reception log.
+
+    Args:
+        data: The rssi_log bytes of the log.
+        encoding: The rssi_encoding of the log.
+
+    Returns:
+        The samples in dBm, oldest first.
+    """
+    if encoding == packet_pb2.RSSI_HALF_DB:
+        return [-raw / 2 for raw in data]
+
+    if encoding == packet_pb2.RSSI_DELTA:
+        samples = []
+        raw = 0
+        value = 0
+        shift = 0
+        for byte in data:
+            value |= (byte & 0x7F) << shift
+            shift += 7
+            if byte & 0x80:
+                continue
+            raw += (value >> 1) ^ -(value & 1)
+            samples.append(-raw / 2)
+            value = 0
+            shift = 0
+        return samples
+
+    return list(struct.unpack(f"<{len(data) // 4}i", data[: len(data) // 4 * 4]))
+
+
+def summarize_rssi(summary):
+    """
+    Flatten the per-packet RSSI summary of a reception log into columns.
+
+    Args:
+        summary: The rssi_summary of the log.
+
+    Returns:
+        A dict of rssi_count, rssi_min, rssi_max, rssi_mean, rssi_variance and
+        the rssi_p10/p50/p90 percentiles, in dBm (dB^2 for the variance).
+    """
+    return {
+        "rssi_count": summary.count,
+        "rssi_min": summary.min,
+        "rssi_max": summary.max,
+        "rssi_mean": summary.mean,
+        "rssi_variance": summary.variance,
+        "rssi_p10": summary.p10,
+        "rssi_p50": summary.p50,
+        "rssi_p90": summary.p90,
+    }
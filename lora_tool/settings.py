@@ -1,5 +1,4 @@
 import proto.packet_pb2 as packet_pb2
-from lora_tool.constants import START_MARKER, END_MARKER
 
 
 def update_settings(
@@ -12,6 +11,20 @@ def update_settings(
     preamble,
     set_crc,
     sync_word,
+    batch_size=0,
+    batch_timeout_ms=250,
+    tx_overflow=packet_pb2.TX_OVERFLOW_BLOCK,
+    tx_burst=False,
+    aggregate_bytes=0,
+    aggregate_timeout_ms=50,
+    rssi_period_us=0,
+    rssi_encoding=packet_pb2.RSSI_INT32,
+    probe_window=0,
+    ladder=None,
+    adapt_interval_ms=0,
+    adapt_target_per_ppm=10000,
+    adapt_margin_db=3.0,
+    adapt_hysteresis_db=2.0,
 ):
     """
     Build and send a SETTINGS packet through the given LoRa device.
@@ -26,6 +39,21 @@ def update_settings(
         preamble: The preamble length.
         set_crc: Boolean to enable or disable CRC.
         sync_word: The synchronization word.
+        batch_size: Reception logs per LOG_BATCH packet (0 or 1 disables batching).
+        batch_timeout_ms: Longest a reception log may be held in a batch (in ms).
+        tx_overflow: What the device does with a transmission when its TX queue is full.
+        tx_burst: Stage the next payload in the radio while the current one is on air.
+        aggregate_bytes: Pack transmissions into LoRa payloads of up to this many bytes (0 disables).
+        aggregate_timeout_ms: Longest a transmission may wait to be packed (in ms).
+        rssi_period_us: RSSI sample period during reception (in us, 0 for one symbol).
+        rssi_encoding: How the device packs the RSSI samples of a reception log.
+        probe_window: Probe packets per PROBE_REPORT from the receiver (0 disables the probe test).
+        ladder: Link adaptation rungs as (spreading_factor, bandwidth, coding_rate, power)
+            tuples, most robust first.
+        adapt_interval_ms: Link adaptation poll interval (in ms, 0 disables adaptation).
+        adapt_target_per_ppm: Highest packet error rate tolerated on a rung (in ppm).
+        adapt_margin_db: SNR margin over the demodulation floor a rung must keep (in dB).
+        adapt_hysteresis_db: Extra margin required before stepping up a rung (in dB).
     """
     if device.ser:
         settings_packet = packet_pb2.Packet()
@@ -38,7 +66,22 @@ def update_settings(
         settings_packet.settings.preamble = preamble
         settings_packet.settings.set_crc = set_crc
         settings_packet.settings.sync_word = sync_word
+        settings_packet.settings.batch_size = batch_size
+        settings_packet.settings.batch_timeout_ms = batch_timeout_ms
+        settings_packet.settings.tx_overflow = tx_overflow
+        settings_packet.settings.tx_burst = tx_burst
+        settings_packet.settings.aggregate_bytes = aggregate_bytes
+        settings_packet.settings.aggregate_timeout_ms = aggregate_timeout_ms
+        settings_packet.settings.rssi_period_us = rssi_period_us
+        settings_packet.settings.rssi_encoding = rssi_encoding
+        settings_packet.settings.probe_window = probe_window
+        for sf, bw, cr, rung_power in ladder or []:
+            settings_packet.settings.ladder.add(
+                spreading_factor=sf, bandwidth=bw, coding_rate=cr, power=rung_power
+            )
+        settings_packet.settings.adapt_interval_ms = adapt_interval_ms
+        settings_packet.settings.adapt_target_per_ppm = adapt_target_per_ppm
+        settings_packet.settings.adapt_margin_db = adapt_margin_db
+        settings_packet.settings.adapt_hysteresis_db = adapt_hysteresis_db
 
-        serialized = settings_packet.SerializeToString()
-        framed = START_MARKER + serialized + END_MARKER
-        device.ser.write(framed)
+        device.send_packet(settings_packet)
@@ -9,3 +9,15 @@ def parse_boolean_input(value: str) -> bool:
         return False
     else:
         raise ValueError(f"Invalid boolean input: {value}. Expected 'true' or 'false'.")
+
+
+def parse_ladder(value: str) -> list:
+    rungs = []
+    for rung in value.replace(" ", "").split(","):
+        if not rung:
+            continue
+        parts = rung.split("/")
+        if len(parts) != 4:
+            raise ValueError(f"Invalid ladder rung: {rung}. Expected 'sf/bw/cr/power'.")
+        rungs.append((int(parts[0]), float(parts[1]), int(parts[2]), int(parts[3])))
+    return rungs
@@ -24,27 +24,59 @@ _sym_db = _symbol_database.Default()
 
 
 
-DESCRIPTOR = _descriptor_pool.Default().AddSerializedFile(b'\n\x0cpacket.proto\"\xa4\x01\n\x08Settings\x12\x11\n\tfrequency\x18\x01 \x01(\x02\x12\r\n\x05power\x18\x02 \x01(\x05\x12\x11\n\tbandwidth\x18\x03 \x01(\x02\x12\x18\n\x10spreading_factor\x18\x04 \x01(\x05\x12\x13\n\x0b\x63oding_rate\x18\x05 \x01(\x05\x12\x10\n\x08preamble\x18\x06 \x01(\x05\x12\x0f\n\x07set_crc\x18\x07 \x01(\x08\x12\x11\n\tsync_word\x18\x08 \x01(\r\"\x1f\n\x0cTransmission\x12\x0f\n\x07payload\x18\x01 \x01(\x0c\">\n\x03Gps\x12\x10\n\x08latitude\x18\x01 \x01(\x01\x12\x11\n\tlongitude\x18\x02 \x01(\x01\x12\x12\n\nsatellites\x18\x03 \x01(\r\"\x84\x01\n\x03Log\x12\x11\n\tcrc_error\x18\x01 \x01(\x08\x12\x15\n\rgeneral_error\x18\x02 \x01(\x08\x12\x11\n\x03gps\x18\x03 \x01(\x0b\x32\x04.Gps\x12\x10\n\x08rssi_log\x18\x04 \x01(\x0c\x12\x10\n\x08rssi_avg\x18\x05 \x01(\x02\x12\x0b\n\x03snr\x18\x06 \x01(\x02\x12\x0f\n\x07payload\x18\x07 \x01(\x0c\"U\n\x07Request\x12\x0e\n\x06search\x18\x01 \x01(\x08\x12\x10\n\x08settings\x18\x02 \x01(\x08\x12\x0b\n\x03gps\x18\x03 \x01(\x08\x12\x1b\n\x0bstateChange\x18\x04 \x01(\x0e\x32\x06.State\"\xb3\x01\n\x06Packet\x12\x19\n\x04type\x18\x01 \x01(\x0e\x32\x0b.PacketType\x12\x1b\n\x08settings\x18\x02 \x01(\x0b\x32\t.Settings\x12#\n\x0ctransmission\x18\x03 \x01(\x0b\x32\r.Transmission\x12\x11\n\x03log\x18\x04 \x01(\x0b\x32\x04.Log\x12\x19\n\x07request\x18\x05 \x01(\x0b\x32\x08.Request\x12\x11\n\x03gps\x18\x06 \x01(\x0b\x32\x04.Gps\x12\x0b\n\x03\x61\x63k\x18\x07 \x01(\x08*e\n\nPacketType\x12\x0f\n\x0bUNSPECIFIED\x10\x00\x12\x0c\n\x08SETTINGS\x10\x01\x12\x10\n\x0cTRANSMISSION\x10\x02\x12\x07\n\x03LOG\x10\x03\x12\x0b\n\x07REQUEST\x10\x04\x12\x07\n\x03GPS\x10\x05\x12\x07\n\x03\x41\x43K\x10\x06*3\n\x05State\x12\x0b\n\x07STANDBY\x10\x00\x12\x0f\n\x0bTRANSMITTER\x10\x01\x12\x0c\n\x08RECEIVER\x10\x02\x62\x06proto3')
+DESCRIPTOR = _descriptor_pool.Default().AddSerializedFile(b'\n\x0cpacket.proto\"[\n\x08LinkRung\x12\x18\n\x10spreading_factor\x18\x01 \x01(\x05\x12\x11\n\tbandwidth\x18\x02 \x01(\x02\x12\x13\n\x0b\x63oding_rate\x18\x03 \x01(\x05\x12\r\n\x05power\x18\x04 \x01(\x05\"\x9b\x04\n\x08Settings\x12\x11\n\tfrequency\x18\x01 \x01(\x02\x12\r\n\x05power\x18\x02 \x01(\x05\x12\x11\n\tbandwidth\x18\x03 \x01(\x02\x12\x18\n\x10spreading_factor\x18\x04 \x01(\x05\x12\x13\n\x0b\x63oding_rate\x18\x05 \x01(\x05\x12\x10\n\x08preamble\x18\x06 \x01(\x05\x12\x0f\n\x07set_crc\x18\x07 \x01(\x08\x12\x11\n\tsync_word\x18\x08 \x01(\r\x12\x12\n\nbatch_size\x18\t \x01(\r\x12\x18\n\x10\x62\x61tch_timeout_ms\x18\n \x01(\r\x12 \n\x0btx_overflow\x18\x0b \x01(\x0e\x32\x0b.TxOverflow\x12\x10\n\x08tx_burst\x18\x0c \x01(\x08\x12\x17\n\x0f\x61ggregate_bytes\x18\r \x01(\r\x12\x1c\n\x14\x61ggregate_timeout_ms\x18\x0e \x01(\r\x12\x16\n\x0erssi_period_us\x18\x0f \x01(\r\x12$\n\rrssi_encoding\x18\x10 \x01(\x0e\x32\r.RssiEncoding\x12\x14\n\x0cprobe_window\x18\x11 \x01(\r\x12\x19\n\x06ladder\x18\x12 \x03(\x0b\x32\t.LinkRung\x12\x19\n\x11\x61\x64\x61pt_interval_ms\x18\x13 \x01(\r\x12\x1c\n\x14\x61\x64\x61pt_target_per_ppm\x18\x14 \x01(\r\x12\x17\n\x0f\x61\x64\x61pt_margin_db\x18\x15 \x01(\x02\x12\x1b\n\x13\x61\x64\x61pt_hysteresis_db\x18\x16 \x01(\x02\"1\n\x0cTransmission\x12\x0f\n\x07payload\x18\x01 \x01(\x0c\x12\x10\n\x08sequence\x18\x02 \x01(\r\"\xc9\x01\n\x03Gps\x12\x10\n\x08latitude\x18\x01 \x01(\x01\x12\x11\n\tlongitude\x18\x02 \x01(\x01\x12\x12\n\nsatellites\x18\x03 \x01(\r\x12\x12\n\nfix_age_ms\x18\x04 \x01(\r\x12\x13\n\x0blatitude_e7\x18\x05 \x01(\x11\x12\x14\n\x0clongitude_e7\x18\x06 \x01(\x11\x12\x12\n\nhdop_centi\x18\x07 \x01(\r\x12\x12\n\nspeed_cm_s\x18\x08 \x01(\r\x12\x13\n\x0b\x63ourse_cdeg\x18\t \x01(\r\x12\r\n\x05\x64\x65lta\x18\n \x01(\x08\"}\n\x0bRssiSummary\x12\r\n\x05\x63ount\x18\x01 \x01(\r\x12\x0b\n\x03min\x18\x02 \x01(\x02\x12\x0b\n\x03max\x18\x03 \x01(\x02\x12\x0c\n\x04mean\x18\x04 \x01(\x02\x12\x10\n\x08variance\x18\x05 \x01(\x02\x12\x0b\n\x03p10\x18\x06 \x01(\x02\x12\x0b\n\x03p50\x18\x07 \x01(\x02\x12\x0b\n\x03p90\x18\x08 \x01(\x02\"\xcb\x04\n\x03Log\x12\x11\n\tcrc_error\x18\x01 \x01(\x08\x12\x15\n\rgeneral_error\x18\x02 \x01(\x08\x12\x11\n\x03gps\x18\x03 \x01(\x0b\x32\x04.Gps\x12\x10\n\x08rssi_log\x18\x04 \x01(\x0c\x12\x10\n\x08rssi_avg\x18\x05 \x01(\x02\x12\x0b\n\x03snr\x18\x06 \x01(\x02\x12\x0f\n\x07payload\x18\x07 \x01(\x0c\x12\x17\n\x0f\x62\x61tch_offset_ms\x18\x08 \x01(\r\x12\x11\n\ttx_queued\x18\t \x01(\r\x12\x13\n\x0btx_rejected\x18\n \x01(\r\x12\x19\n\x11tx_dropped_newest\x18\x0b \x01(\r\x12\x19\n\x11tx_dropped_oldest\x18\x0c \x01(\r\x12\x13\n\x0b\x66rame_index\x18\r \x01(\r\x12\x13\n\x0b\x66rame_count\x18\x0e \x01(\r\x12\x16\n\x0erssi_period_us\x18\x0f \x01(\r\x12\x13\n\x0brssi_missed\x18\x10 \x01(\r\x12$\n\rrssi_encoding\x18\x11 \x01(\x0e\x32\r.RssiEncoding\x12\"\n\x0crssi_summary\x18\x12 \x01(\x0b\x32\x0c.RssiSummary\x12\x17\n\x0fheader_valid_us\x18\x13 \x01(\x04\x12\x12\n\nrx_done_us\x18\x14 \x01(\x04\x12\x13\n\x0btx_start_us\x18\x15 \x01(\x04\x12\x17\n\x0fprev_tx_done_us\x18\x16 \x01(\x04\x12\x16\n\x0etime_on_air_us\x18\x17 \x01(\r\x12\"\n\x0c\x63lock_source\x18\x18 \x01(\x0e\x32\x0c.ClockSource\x12\x16\n\x0e\x63lock_error_us\x18\x19 \x01(\r\"C\n\x08LogBatch\x12\x11\n\x03gps\x18\x01 \x01(\x0b\x32\x04.Gps\x12\x10\n\x08start_ms\x18\x02 \x01(\r\x12\x12\n\x04logs\x18\x03 \x03(\x0b\x32\x04.Log\"f\n\x08Schedule\x12\x11\n\tperiod_us\x18\x01 \x01(\r\x12\x16\n\x0epayload_length\x18\x02 \x01(\r\x12 \n\x07pattern\x18\x03 \x01(\x0e\x32\x0f.PayloadPattern\x12\r\n\x05\x63ount\x18\x04 \x01(\r\"\xd9\x01\n\x07Request\x12\x0e\n\x06search\x18\x01 \x01(\x08\x12\x10\n\x08settings\x18\x02 \x01(\x08\x12\x0b\n\x03gps\x18\x03 \x01(\x08\x12\x1b\n\x0bstateChange\x18\x04 \x01(\x0e\x32\x06.State\x12\x19\n\x07\x66raming\x18\x05 \x01(\x0e\x32\x08.Framing\x12\r\n\x05stats\x18\x06 \x01(\x08\x12\x11\n\tbaud_rate\x18\x07 \x01(\r\x12\x13\n\x0b\x62\x61ud_commit\x18\x08 \x01(\x08\x12\x1b\n\x08schedule\x18\t \x01(\x0b\x32\t.Schedule\x12\x13\n\x0b\x63redit_poll\x18\n \x01(\r\"k\n\x08LinkTest\x12\x10\n\x08sequence\x18\x01 \x01(\r\x12\x0f\n\x07payload\x18\x02 \x01(\x0c\x12\x11\n\trx_frames\x18\x03 \x01(\r\x12\x11\n\trx_errors\x18\x04 \x01(\r\x12\x16\n\x0erx_bytes_per_s\x18\x05 \x01(\r\"N\n\x06\x43redit\x12\x10\n\x08sequence\x18\x01 \x01(\r\x12\x0f\n\x07\x63redits\x18\x02 \x01(\r\x12\x10\n\x08\x63\x61pacity\x18\x03 \x01(\r\x12\x0f\n\x07\x65victed\x18\x04 \x01(\r\"^\n\x07Latency\x12\x0f\n\x07samples\x18\x01 \x01(\r\x12\x0e\n\x06min_us\x18\x02 \x01(\r\x12\x0f\n\x07mean_us\x18\x03 \x01(\r\x12\x0e\n\x06max_us\x18\x04 \x01(\r\x12\x11\n\tstddev_us\x18\x05 \x01(\r\"\x9a\x07\n\x05Stats\x12\x11\n\trx_frames\x18\x01 \x01(\r\x12\x15\n\rrx_crc_errors\x18\x02 \x01(\r\x12\x14\n\x0crx_overflows\x18\x03 \x01(\r\x12\x14\n\x0crx_malformed\x18\x04 \x01(\r\x12\x12\n\npool_slots\x18\x05 \x01(\r\x12\x11\n\tpool_free\x18\x06 \x01(\r\x12\x15\n\rpool_min_free\x18\x07 \x01(\r\x12\x16\n\x0epool_exhausted\x18\x08 \x01(\r\x12\x12\n\nqueue_full\x18\t \x01(\r\x12!\n\x0f\x63ommand_latency\x18\n \x01(\x0b\x32\x08.Latency\x12\x11\n\ttx_frames\x18\x0b \x01(\r\x12\x12\n\ntx_dropped\x18\x0c \x01(\r\x12\x16\n\x0etx_overwritten\x18\r \x01(\r\x12\x14\n\x0ctx_ring_size\x18\x0e \x01(\r\x12\x15\n\rtx_high_water\x18\x0f \x01(\r\x12\x18\n\x06tx_gap\x18\x10 \x01(\x0b\x32\x08.Latency\x12\x12\n\ntx_started\x18\x11 \x01(\r\x12\x12\n\nsched_sent\x18\x12 \x01(\r\x12\x14\n\x0csched_missed\x18\x13 \x01(\r\x12\x16\n\x0esched_rate_mhz\x18\x14 \x01(\r\x12\x1d\n\x0bsched_delay\x18\x15 \x01(\x0b\x32\x08.Latency\x12 \n\x0esched_interval\x18\x16 \x01(\x0b\x32\x08.Latency\x12\x1f\n\rrx_turnaround\x18\x17 \x01(\x0b\x32\x08.Latency\x12\x1a\n\x12rx_capture_dropped\x18\x18 \x01(\r\x12\"\n\x10reconfigure_time\x18\x19 \x01(\x0b\x32\x08.Latency\x12\x1a\n\x12image_calibrations\x18\x1a \x01(\r\x12\x15\n\rgps_sentences\x18\x1b \x01(\r\x12\x1b\n\x13gps_checksum_errors\x18\x1c \x01(\r\x12\x17\n\x0fgps_fix_rate_hz\x18\x1d \x01(\x02\x12 \n\x0egps_parse_time\x18\x1e \x01(\x0b\x32\x08.Latency\x12\x17\n\x0fgps_interval_ms\x18\x1f \x01(\r\x12\x0f\n\x07gps_ubx\x18  \x01(\x08\x12\"\n\x0c\x63lock_source\x18! \x01(\x0e\x32\x0c.ClockSource\x12\x16\n\x0e\x63lock_error_us\x18\" \x01(\r\x12\x11\n\tpps_edges\x18# \x01(\r\x12\x13\n\x0b\x63lock_steps\x18$ \x01(\r\x12\x17\n\x0f\x63lock_drift_ppm\x18% \x01(\x02\"\xf7\x02\n\x0bProbeReport\x12\x0e\n\x06window\x18\x01 \x01(\r\x12\x10\n\x08\x65xpected\x18\x02 \x01(\r\x12\x10\n\x08received\x18\x03 \x01(\r\x12\x0c\n\x04lost\x18\x04 \x01(\r\x12\x12\n\nduplicates\x18\x05 \x01(\r\x12\x11\n\treordered\x18\x06 \x01(\r\x12\x12\n\ncrc_errors\x18\x07 \x01(\r\x12\x0f\n\x07per_ppm\x18\x08 \x01(\r\x12\x17\n\x0f\x63lock_offset_us\x18\t \x01(\x12\x12\x16\n\x0elatency_p50_us\x18\n \x01(\r\x12\x16\n\x0elatency_p90_us\x18\x0b \x01(\r\x12\x16\n\x0elatency_p99_us\x18\x0c \x01(\r\x12\x16\n\x0elatency_max_us\x18\r \x01(\r\x12\x0e\n\x06\x62ursts\x18\x0e \x01(\r\x12\x11\n\tburst_max\x18\x0f \x01(\r\x12\x12\n\nburst_hist\x18\x10 \x03(\r\x12\x16\n\x0etotal_received\x18\x11 \x01(\r\x12\x12\n\ntotal_lost\x18\x12 \x01(\r\"\xcd\x01\n\tLinkAdapt\x12\x0c\n\x04rung\x18\x01 \x01(\r\x12\x15\n\rprevious_rung\x18\x02 \x01(\r\x12\x1c\n\x06reason\x18\x03 \x01(\x0e\x32\x0c.AdaptReason\x12\x0f\n\x07\x61pplied\x18\x04 \x01(\x08\x12\x0c\n\x04sent\x18\x05 \x01(\r\x12\x10\n\x08received\x18\x06 \x01(\r\x12\x0f\n\x07per_ppm\x18\x07 \x01(\r\x12\x0b\n\x03snr\x18\x08 \x01(\x02\x12\x11\n\tmargin_db\x18\t \x01(\x02\x12\x1b\n\x08settings\x18\n \x01(\x0b\x32\t.LinkRung\"\xe3\x02\n\x06Packet\x12\x19\n\x04type\x18\x01 \x01(\x0e\x32\x0b.PacketType\x12\x1b\n\x08settings\x18\x02 \x01(\x0b\x32\t.Settings\x12#\n\x0ctransmission\x18\x03 \x01(\x0b\x32\r.Transmission\x12\x11\n\x03log\x18\x04 \x01(\x0b\x32\x04.Log\x12\x19\n\x07request\x18\x05 \x01(\x0b\x32\x08.Request\x12\x11\n\x03gps\x18\x06 \x01(\x0b\x32\x04.Gps\x12\x0b\n\x03\x61\x63k\x18\x07 \x01(\x08\x12\x15\n\x05stats\x18\x08 \x01(\x0b\x32\x06.Stats\x12\x1c\n\tlog_batch\x18\t \x01(\x0b\x32\t.LogBatch\x12\x1c\n\tlink_test\x18\n \x01(\x0b\x32\t.LinkTest\x12\x17\n\x06\x63redit\x18\x0b \x01(\x0b\x32\x07.Credit\x12\"\n\x0cprobe_report\x18\x0c \x01(\x0b\x32\x0c.ProbeReport\x12\x1e\n\nlink_adapt\x18\r \x01(\x0b\x32\n.LinkAdapt*\xb0\x01\n\nPacketType\x12\x0f\n\x0bUNSPECIFIED\x10\x00\x12\x0c\n\x08SETTINGS\x10\x01\x12\x10\n\x0cTRANSMISSION\x10\x02\x12\x07\n\x03LOG\x10\x03\x12\x0b\n\x07REQUEST\x10\x04\x12\x07\n\x03GPS\x10\x05\x12\x07\n\x03\x41\x43K\x10\x06\x12\t\n\x05STATS\x10\x07\x12\r\n\tLOG_BATCH\x10\x08\x12\r\n\tLINK_TEST\x10\t\x12\x10\n\x0cPROBE_REPORT\x10\n\x12\x0e\n\nLINK_ADAPT\x10\x0b*3\n\x05State\x12\x0b\n\x07STANDBY\x10\x00\x12\x0f\n\x0bTRANSMITTER\x10\x01\x12\x0c\n\x08RECEIVER\x10\x02*I\n\x07\x46raming\x12\x15\n\x11\x46RAMING_UNCHANGED\x10\x00\x12\x15\n\x11\x46RAMING_DELIMITED\x10\x01\x12\x10\n\x0c\x46RAMING_COBS\x10\x02*]\n\nTxOverflow\x12\x15\n\x11TX_OVERFLOW_BLOCK\x10\x00\x12\x1b\n\x17TX_OVERFLOW_DROP_NEWEST\x10\x01\x12\x1b\n\x17TX_OVERFLOW_DROP_OLDEST\x10\x02*`\n\x0ePayloadPattern\x12\x14\n\x10PATTERN_SEQUENCE\x10\x00\x12\x12\n\x0ePATTERN_RANDOM\x10\x01\x12\x11\n\rPATTERN_ZEROS\x10\x02\x12\x11\n\rPATTERN_PROBE\x10\x03*R\n\x0cRssiEncoding\x12\x0e\n\nRSSI_INT32\x10\x00\x12\x10\n\x0cRSSI_HALF_DB\x10\x01\x12\x0e\n\nRSSI_DELTA\x10\x02\x12\x10\n\x0cRSSI_SUMMARY\x10\x03*\x9b\x01\n\x0b\x41\x64\x61ptReason\x12\x0f\n\x0b\x41\x44\x41PT_START\x10\x00\x12\x12\n\x0e\x41\x44\x41PT_PER_HIGH\x10\x01\x12\x14\n\x10\x41\x44\x41PT_MARGIN_LOW\x10\x02\x12\x15\n\x11\x41\x44\x41PT_MARGIN_HIGH\x10\x03\x12\x15\n\x11\x41\x44\x41PT_NO_FEEDBACK\x10\x04\x12\x13\n\x0f\x41\x44\x41PT_LINK_LOST\x10\x05\x12\x0e\n\nADAPT_PEER\x10\x06*=\n\x0b\x43lockSource\x12\x0f\n\x0b\x43LOCK_LOCAL\x10\x00\x12\x0e\n\nCLOCK_GNSS\x10\x01\x12\r\n\tCLOCK_PPS\x10\x02\x62\x06proto3')
 
 _globals = globals()
 _builder.BuildMessageAndEnumDescriptors(DESCRIPTOR, _globals)
 _builder.BuildTopDescriptorsAndMessages(DESCRIPTOR, 'packet_pb2', _globals)
 if not _descriptor._USE_C_DESCRIPTORS:
   DESCRIPTOR._loaded_options = None
-  _globals['_PACKETTYPE']._serialized_start=684
-  _globals['_PACKETTYPE']._serialized_end=785
-  _globals['_STATE']._serialized_start=787
-  _globals['_STATE']._serialized_end=838
-  _globals['_SETTINGS']._serialized_start=17
-  _globals['_SETTINGS']._serialized_end=181
-  _globals['_TRANSMISSION']._serialized_start=183
-  _globals['_TRANSMISSION']._serialized_end=214
-  _globals['_GPS']._serialized_start=216
-  _globals['_GPS']._serialized_end=278
-  _globals['_LOG']._serialized_start=281
-  _globals['_LOG']._serialized_end=413
-  _globals['_REQUEST']._serialized_start=415
-  _globals['_REQUEST']._serialized_end=500
-  _globals['_PACKET']._serialized_start=503
-  _globals['_PACKET']._serialized_end=682
+  _globals['_PACKETTYPE']._serialized_start=4171
+  _globals['_PACKETTYPE']._serialized_end=4347
+  _globals['_STATE']._serialized_start=4349
+  _globals['_STATE']._serialized_end=4400
+  _globals['_FRAMING']._serialized_start=4402
+  _globals['_FRAMING']._serialized_end=4475
+  _globals['_TXOVERFLOW']._serialized_start=4477
+  _globals['_TXOVERFLOW']._serialized_end=4570
+  _globals['_PAYLOADPATTERN']._serialized_start=4572
+  _globals['_PAYLOADPATTERN']._serialized_end=4668
+  _globals['_RSSIENCODING']._serialized_start=4670
+  _globals['_RSSIENCODING']._serialized_end=4752
+  _globals['_ADAPTREASON']._serialized_start=4755
+  _globals['_ADAPTREASON']._serialized_end=4910
+  _globals['_CLOCKSOURCE']._serialized_start=4912
+  _globals['_CLOCKSOURCE']._serialized_end=4973
+  _globals['_LINKRUNG']._serialized_start=16
+  _globals['_LINKRUNG']._serialized_end=107
+  _globals['_SETTINGS']._serialized_start=110
+  _globals['_SETTINGS']._serialized_end=649
+  _globals['_TRANSMISSION']._serialized_start=651
+  _globals['_TRANSMISSION']._serialized_end=700
+  _globals['_GPS']._serialized_start=703
+  _globals['_GPS']._serialized_end=904
+  _globals['_RSSISUMMARY']._serialized_start=906
+  _globals['_RSSISUMMARY']._serialized_end=1031
+  _globals['_LOG']._serialized_start=1034
+  _globals['_LOG']._serialized_end=1621
+  _globals['_LOGBATCH']._serialized_start=1623
+  _globals['_LOGBATCH']._serialized_end=1690
+  _globals['_SCHEDULE']._serialized_start=1692
+  _globals['_SCHEDULE']._serialized_end=1794
+  _globals['_REQUEST']._serialized_start=1797
+  _globals['_REQUEST']._serialized_end=2014
+  _globals['_LINKTEST']._serialized_start=2016
+  _globals['_LINKTEST']._serialized_end=2123
+  _globals['_CREDIT']._serialized_start=2125
+  _globals['_CREDIT']._serialized_end=2203
+  _globals['_LATENCY']._serialized_start=2205
+  _globals['_LATENCY']._serialized_end=2299
+  _globals['_STATS']._serialized_start=2302
+  _globals['_STATS']._serialized_end=3224
+  _globals['_PROBEREPORT']._serialized_start=3227
+  _globals['_PROBEREPORT']._serialized_end=3602
+  _globals['_LINKADAPT']._serialized_start=3605
+  _globals['_LINKADAPT']._serialized_end=3810
+  _globals['_PACKET']._serialized_start=3813
+  _globals['_PACKET']._serialized_end=4168
 # @@protoc_insertion_point(module_scope)
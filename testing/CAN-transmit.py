@@ -1,3 +1,14 @@
+"""
+Forward CAN frames to the LoRa device, one TRANSMISSION per frame.
+
+Each frame is still sent to the device on its own. With aggregation enabled in
+the device settings (aggregate_bytes > 0, e.g. 255 with a 50 ms timeout) the
+firmware packs consecutive frames into one LoRa payload, so the preamble,
+header and CRC are paid once per packet rather than once per 8-byte frame.
+A receiver with the same setting reports every frame as its own Log, with
+frame_index/frame_count giving its position in the packet.
+"""
+
 import proto.packet_pb2 as packet_pb2
 import time
 import serial
@@ -0,0 +1,69 @@
+"""
+Pair a transmitter's and a receiver's saved logs on their UTC timestamps.
+
+Both devices stamp every log with a clock disciplined by GNSS time and, where
+the module's PPS pin is wired, the PPS pulse, so the logs of one packet can be
+joined directly instead of by matching payloads or host arrival times. Prints
+how many receptions matched, the clock sources seen, and the spread of the
+transmission-end to RX_DONE latency, and writes the joined rows next to the
+reception log.
+
+Usage (from the repository root):
+    python testing/align-logs.py receiver_tests/tx_....parquet receiver_tests/rx_....parquet
+"""
+
+import argparse
+import os
+import sys
+
+sys.path.insert(0, os.path.join(os.path.dirname(__file__), ".."))
+
+import pandas as pd
+
+import proto.packet_pb2 as packet_pb2
+from lora_tool.data_handler import align_logs
+
+
+def describe_clock(name, logs):
+    """
+    Print how a device's logs were stamped.
+    """
+    counts = logs["clock_source"].value_counts()
+    sources = ", ".join(
+        f"{packet_pb2.ClockSource.Name(int(source))} {count}"
+        for source, count in counts.items()
+    )
+    synced = logs[logs["clock_source"] != packet_pb2.ClockSource.CLOCK_LOCAL]
+    error = f", error p50 {synced['clock_error_us'].median():.0f} us" if len(synced) else ""
+    print(f"{name}: {len(logs)} logs ({sources}){error}")
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[1])
+    parser.add_argument("tx_log")
+    parser.add_argument("rx_log")
+    parser.add_argument("--guard-us", type=int, default=2000)
+    args = parser.parse_args()
+
+    transmit_logs = pd.read_parquet(args.tx_log)
+    reception_logs = pd.read_parquet(args.rx_log)
+    describe_clock("transmitter", transmit_logs)
+    describe_clock("receiver", reception_logs)
+
+    joined = align_logs(transmit_logs, reception_logs, args.guard_us)
+    print(f"matched {len(joined)} of {len(reception_logs)} receptions")
+    if joined.empty:
+        return
+
+    latency = joined["latency_us"]
+    print(
+        f"latency us: min {latency.min()}  p50 {latency.median():.0f}  "
+        f"p99 {latency.quantile(0.99):.0f}  max {latency.max()}"
+    )
+    output = os.path.splitext(args.rx_log)[0] + "_aligned.parquet"
+    joined.to_parquet(output, index=False)
+    print(f"wrote {output}")
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,164 @@
+"""
+Benchmark back-to-back LoRa transmission with and without burst (ping-pong) mode.
+
+For each spreading factor the device is configured once with normal and once
+with burst transmission, then fed payloads through the credit window. Sustained
+packets/s comes from the arrival of the transmit logs, which the device emits
+as each packet starts; the inter-packet gap (TX_DONE to the next start, for
+payloads that were already waiting) comes from the device's tx_gap counters.
+The busy column is packets/s x time-on-air, i.e. how much of the time the
+radio was actually on air.
+
+At SF5/BW500 the 115200 baud link cannot keep up with the radio, so pass
+--baud to negotiate a faster link first.
+
+Usage (from the repository root):
+    python testing/burst-benchmark.py COM7 --count 300 --bytes 16 --baud 921600
+"""
+
+import argparse
+import math
+import os
+import sys
+import time
+
+sys.path.insert(0, os.path.join(os.path.dirname(__file__), ".."))
+
+import proto.packet_pb2 as packet_pb2
+from lora_tool.flow_control import CreditWindow
+from lora_tool.framing import FrameDecoder
+from lora_tool.lora_device import LoRaDevice
+from lora_tool.serial_comm import open_serial_port
+from lora_tool.settings import update_settings
+
+
+def time_on_air(sf, bw_khz, coding_rate, preamble, length, crc=True):
+    """
+    Time on air of an explicit-header LoRa packet, per the SX1261/2 datasheet.
+
+    Args:
+        sf: Spreading factor.
+        bw_khz: Bandwidth in kHz.
+        coding_rate: Coding rate denominator (5 for 4/5 ... 8 for 4/8).
+        preamble: Preamble length in symbols.
+        length: Payload length in bytes.
+        crc: True if the payload CRC is enabled.
+
+    Returns:
+        The time on air in seconds.
+    """
+    symbol_time = (1 << sf) / (bw_khz * 1000.0)
+    crc_bits = 16 if crc else 0
+    if sf < 7:
+        preamble_symbols = preamble + 6.25
+        bits = 8 * length + crc_bits - 4 * sf + 20
+        divisor = 4 * sf
+    else:
+        preamble_symbols = preamble + 4.25
+        bits = 8 * length + crc_bits - 4 * sf + 8 + 20
+        low_data_rate = symbol_time > 0.016
+        divisor = 4 * (sf - 2 if low_data_rate else sf)
+    payload_symbols = 8 + math.ceil(max(bits, 0) / divisor) * coding_rate
+    return (preamble_symbols + payload_symbols) * symbol_time
+
+
+def run_stream(device, count, size, timeout):
+    """
+    Send `count` payloads as fast as the credit window allows.
+
+    Returns:
+        The host arrival times of the transmit logs and the number of rejected payloads.
+    """
+    window = CreditWindow()
+    device.decoder = FrameDecoder(device.framing)
+    starts = []
+    sent = 0
+
+    def fill_window():
+        nonlocal sent
+        while sent < count and window.available() > 0:
+            device.send_transmission(os.urandom(size), sequence=window.on_sent())
+            sent += 1
+
+    fill_window()
+    deadline = time.time() + timeout
+    while len(starts) < count and time.time() < deadline:
+        for message in device.decoder.feed(device.ser.read(device.ser.in_waiting or 1)):
+            try:
+                packets = device.parse_packets(message)
+            except Exception:
+                continue
+            for packet in packets:
+                if packet.type == packet_pb2.PacketType.ACK:
+                    window.on_ack(packet)
+                elif packet.type == packet_pb2.PacketType.LOG:
+                    starts.append(time.perf_counter())
+        fill_window()
+        poll = window.poll_due()
+        if poll is not None:
+            print(f"  window stalled with {window.unacked} unanswered, polling for credits")
+            device.send_credit_poll(poll)
+    return starts, window.rejected
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[1])
+    parser.add_argument("port")
+    parser.add_argument("--count", type=int, default=300)
+    parser.add_argument("--bytes", type=int, default=16)
+    parser.add_argument("--sf", type=int, nargs="+", default=[5, 6, 7])
+    parser.add_argument("--bw", type=float, default=500.0)
+    parser.add_argument("--cr", type=int, default=5)
+    parser.add_argument("--preamble", type=int, default=8)
+    parser.add_argument("--frequency", type=float, default=915.0)
+    parser.add_argument("--power", type=int, default=22)
+    parser.add_argument("--baud", type=int, help="negotiate this serial baud rate first")
+    args = parser.parse_args()
+
+    device = LoRaDevice(open_serial_port(args.port))
+    time.sleep(1)
+    device.negotiate_framing()
+    if args.baud and device.negotiate_baud(args.baud) is None:
+        print(f"Could not switch to {args.baud} baud, staying at {device.ser.baudrate}")
+
+    print(f"{args.bytes}-byte payloads, BW {args.bw} kHz, CR 4/{args.cr}, {args.count} packets")
+    print("  SF  mode    airtime ms  packets/s   busy %  gap mean us  gap max us  rejected")
+    for sf in args.sf:
+        airtime = time_on_air(sf, args.bw, args.cr, args.preamble, args.bytes)
+        for burst in (False, True):
+            device.change_state(packet_pb2.State.STANDBY)
+            update_settings(
+                device,
+                args.frequency,
+                args.power,
+                args.bw,
+                sf,
+                args.cr,
+                args.preamble,
+                True,
+                0xAB,
+                tx_burst=burst,
+            )
+            time.sleep(0.5)
+            device.change_state(packet_pb2.State.TRANSMITTER)
+            time.sleep(0.2)
+            device.ser.reset_input_buffer()
+
+            starts, rejected = run_stream(
+                device, args.count, args.bytes, timeout=args.count * airtime * 4 + 5
+            )
+            stats = device.request_stats() or {}
+            gap = stats.get("tx_gap")
+
+            rate = (len(starts) - 1) / (starts[-1] - starts[0]) if len(starts) > 1 else 0
+            print(
+                f"  {sf:>2}  {'burst' if burst else 'normal':<6}  {airtime * 1e3:>10.2f}"
+                f"  {rate:>9.1f}  {rate * airtime * 100:>7.1f}"
+                f"  {gap.mean_us if gap else 0:>11}  {gap.max_us if gap else 0:>10}  {rejected:>8}"
+            )
+
+    device.change_state(packet_pb2.State.STANDBY)
+
+
+if __name__ == "__main__":
+    main()
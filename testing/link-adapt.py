@@ -0,0 +1,144 @@
+"""
+Watch closed-loop link adaptation step along a modulation ladder.
+
+Configures both devices with the same ladder and poll interval, puts one in
+RECEIVER and the other in TRANSMITTER state and has the transmitter send
+scheduled payloads. Both devices report every rung proposal and switch as a
+LINK_ADAPT packet; this script prints them as they arrive from either side,
+so the transmitter's decisions can be checked against the receiver's
+switches. Moving the boards apart or lowering --power should make the link
+step down; bringing them back should step it up again after a few polls.
+
+Usage (from the repository root):
+    python testing/link-adapt.py COM7 COM8 --count 2000 --interval-ms 1000
+"""
+
+import argparse
+import os
+import sys
+import threading
+import time
+
+sys.path.insert(0, os.path.join(os.path.dirname(__file__), ".."))
+
+import proto.packet_pb2 as packet_pb2
+from lora_tool.framing import FrameDecoder
+from lora_tool.lora_device import LoRaDevice
+from lora_tool.serial_comm import open_serial_port
+from lora_tool.settings import update_settings
+from lora_tool.utils import parse_ladder
+
+DEFAULT_LADDER = "12/125/8/22,10/125/5/20,9/250/5/17,7/500/5/14"
+
+
+def collect_events(name, device, events, stop):
+    """
+    Read a device's serial port until `stop` is set, printing its LINK_ADAPT packets.
+    """
+    decoder = FrameDecoder(device.framing)
+    while not stop.is_set():
+        for message in decoder.feed(device.ser.read(device.ser.in_waiting or 1)):
+            try:
+                packets = device.parse_packets(message)
+            except Exception:
+                continue
+            for packet in packets:
+                if packet.type != packet_pb2.PacketType.LINK_ADAPT:
+                    continue
+                event = packet.link_adapt
+                events.append((name, event))
+                print(
+                    f"{time.monotonic():10.3f}  {name}  "
+                    f"{'switch ' if event.applied else 'propose'}  {event.previous_rung} -> "
+                    f"{event.rung}  {packet_pb2.AdaptReason.Name(event.reason):<18}"
+                    f"  {event.received:>5}/{event.sent:<5}  PER {event.per_ppm / 1e4:6.2f}%"
+                    f"  SNR {event.snr:6.1f}  margin {event.margin_db:6.1f}"
+                )
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[1])
+    parser.add_argument("rx_port")
+    parser.add_argument("tx_port")
+    parser.add_argument("--ladder", default=DEFAULT_LADDER, help="sf/bw/cr/power,...")
+    parser.add_argument("--interval-ms", type=int, default=1000)
+    parser.add_argument("--target-per", type=float, default=1.0, help="in percent")
+    parser.add_argument("--margin-db", type=float, default=3.0)
+    parser.add_argument("--hysteresis-db", type=float, default=2.0)
+    parser.add_argument("--count", type=int, default=2000)
+    parser.add_argument("--period-ms", type=float, default=200.0)
+    parser.add_argument("--bytes", type=int, default=32)
+    parser.add_argument("--frequency", type=float, default=915.0)
+    args = parser.parse_args()
+
+    ladder = parse_ladder(args.ladder)
+    sf, bw, cr, power = ladder[0]
+    receiver = LoRaDevice(open_serial_port(args.rx_port))
+    transmitter = LoRaDevice(open_serial_port(args.tx_port))
+    time.sleep(1)
+    for device in (receiver, transmitter):
+        device.negotiate_framing()
+        update_settings(
+            device,
+            args.frequency,
+            power,
+            bw,
+            sf,
+            cr,
+            8,
+            True,
+            0xAB,
+            rssi_encoding=packet_pb2.RSSI_SUMMARY,
+            ladder=ladder,
+            adapt_interval_ms=args.interval_ms,
+            adapt_target_per_ppm=int(args.target_per * 1e4),
+            adapt_margin_db=args.margin_db,
+            adapt_hysteresis_db=args.hysteresis_db,
+        )
+    time.sleep(0.5)
+
+    receiver.change_state(packet_pb2.State.RECEIVER)
+    transmitter.change_state(packet_pb2.State.TRANSMITTER)
+    time.sleep(0.2)
+    receiver.ser.reset_input_buffer()
+
+    events = []
+    stop = threading.Event()
+    readers = [
+        threading.Thread(target=collect_events, args=(name, device, events, stop))
+        for name, device in (("RX", receiver), ("TX", transmitter))
+    ]
+    print("      time  side  action   rung    reason               recv/sent         PER        SNR      margin")
+    # Start the schedule by hand: run_schedule would read, and drop, the
+    # transmitter's LINK_ADAPT packets while it waits for the STATS.
+    schedule = transmitter.new_request()
+    schedule.request.schedule.period_us = int(args.period_ms * 1000)
+    schedule.request.schedule.payload_length = args.bytes
+    schedule.request.schedule.count = args.count
+    transmitter.ser.reset_input_buffer()
+    transmitter.send_packet(schedule)
+    for reader in readers:
+        reader.start()
+    try:
+        time.sleep(args.count * args.period_ms * 2e-3 + 1)
+    except KeyboardInterrupt:
+        pass
+
+    receiver.change_state(packet_pb2.State.STANDBY)
+    transmitter.change_state(packet_pb2.State.STANDBY)
+    time.sleep(0.5)
+    stop.set()
+    for reader in readers:
+        reader.join()
+
+    for name in ("TX", "RX"):
+        switches = [e for side, e in events if side == name and e.applied]
+        fallbacks = [
+            e
+            for e in switches
+            if e.reason in (packet_pb2.ADAPT_NO_FEEDBACK, packet_pb2.ADAPT_LINK_LOST)
+        ]
+        print(f"{name}: {len(switches)} rung switches, {len(fallbacks)} fallbacks to rung 0")
+
+if __name__ == "__main__":
+    main()
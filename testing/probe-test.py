@@ -0,0 +1,140 @@
+"""
+Measure packet error rate, loss bursts and one-way latency with probe packets.
+
+Configures the receiver with a probe report window and puts it in RECEIVER
+state, then has a second device send sequence-numbered PATTERN_PROBE payloads
+with the on-device periodic transmitter. The receiver counts loss, duplicates
+and reordering and reports each window as a PROBE_REPORT, which this script
+prints and totals. Latency is relative to the fastest probe of the run; that
+minimum is the true one-way latency only when both boards' clocks are
+disciplined to PPS, and otherwise also holds the offset between the clocks.
+
+The receiver's per-packet logs are kept small (RSSI summary, batched) so the
+serial link does not limit the test.
+
+Usage (from the repository root):
+    python testing/probe-test.py COM7 COM8 --count 1000 --period-ms 50 --window 100
+"""
+
+import argparse
+import os
+import sys
+import threading
+import time
+
+sys.path.insert(0, os.path.join(os.path.dirname(__file__), ".."))
+
+import proto.packet_pb2 as packet_pb2
+from lora_tool.framing import FrameDecoder
+from lora_tool.lora_device import LoRaDevice
+from lora_tool.serial_comm import open_serial_port
+from lora_tool.settings import update_settings
+
+
+def collect_reports(device, reports, stop):
+    """
+    Read the receiver's serial port until `stop` is set, keeping the PROBE_REPORTs.
+    """
+    decoder = FrameDecoder(device.framing)
+    while not stop.is_set():
+        for message in decoder.feed(device.ser.read(device.ser.in_waiting or 1)):
+            try:
+                packets = device.parse_packets(message)
+            except Exception:
+                continue
+            for packet in packets:
+                if packet.type == packet_pb2.PacketType.PROBE_REPORT:
+                    reports.append(packet.probe_report)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[1])
+    parser.add_argument("rx_port")
+    parser.add_argument("tx_port")
+    parser.add_argument("--count", type=int, default=1000)
+    parser.add_argument("--period-ms", type=float, default=50.0)
+    parser.add_argument("--bytes", type=int, default=32)
+    parser.add_argument("--window", type=int, default=100)
+    parser.add_argument("--sf", type=int, default=7)
+    parser.add_argument("--bw", type=float, default=500.0)
+    parser.add_argument("--frequency", type=float, default=915.0)
+    parser.add_argument("--power", type=int, default=22)
+    args = parser.parse_args()
+
+    receiver = LoRaDevice(open_serial_port(args.rx_port))
+    transmitter = LoRaDevice(open_serial_port(args.tx_port))
+    time.sleep(1)
+    for device in (receiver, transmitter):
+        device.negotiate_framing()
+        update_settings(
+            device,
+            args.frequency,
+            args.power,
+            args.bw,
+            args.sf,
+            5,
+            8,
+            True,
+            0xAB,
+            batch_size=8,
+            rssi_encoding=packet_pb2.RSSI_SUMMARY,
+            probe_window=args.window,
+        )
+    time.sleep(0.5)
+
+    receiver.change_state(packet_pb2.State.RECEIVER)
+    transmitter.change_state(packet_pb2.State.TRANSMITTER)
+    time.sleep(0.2)
+    receiver.ser.reset_input_buffer()
+
+    reports = []
+    stop = threading.Event()
+    reader = threading.Thread(target=collect_reports, args=(receiver, reports, stop))
+    reader.start()
+
+    tx_stats = transmitter.run_schedule(
+        int(args.period_ms * 1000),
+        args.bytes,
+        pattern=packet_pb2.PATTERN_PROBE,
+        count=args.count,
+    )
+    time.sleep(0.5)
+    # Leaving RECEIVER makes the device report the partial last window.
+    receiver.change_state(packet_pb2.State.STANDBY)
+    transmitter.change_state(packet_pb2.State.STANDBY)
+    time.sleep(0.5)
+    stop.set()
+    reader.join()
+
+    if tx_stats is None:
+        print("Transmitter refused the schedule")
+        return
+    if not reports:
+        print("Receiver sent no probe reports")
+        return
+
+    print("window  expected  received  lost  dup  reord  crc  PER %  burst max  p50 us  p90 us  p99 us")
+    for r in reports:
+        print(
+            f"{r.window:>6}  {r.expected:>8}  {r.received:>8}  {r.lost:>4}  {r.duplicates:>3}"
+            f"  {r.reordered:>5}  {r.crc_errors:>3}  {r.per_ppm / 1e4:>5.2f}  {r.burst_max:>9}"
+            f"  {r.latency_p50_us:>6}  {r.latency_p90_us:>6}  {r.latency_p99_us:>6}"
+        )
+
+    last = reports[-1]
+    expected = last.total_received + last.total_lost
+    print(
+        f"sent {tx_stats.get('sched_sent', 0)}, received {last.total_received}, "
+        f"lost {last.total_lost} ({100.0 * last.total_lost / max(expected, 1):.2f}% PER)"
+    )
+    source = packet_pb2.ClockSource.Name(tx_stats.get("clock_source", 0))
+    print(
+        f"minimum latency {last.clock_offset_us} us "
+        f"(transmitter clock {source}, error {tx_stats.get('clock_error_us', 0)} us)"
+    )
+    hist = [sum(r.burst_hist[i] for r in reports if len(r.burst_hist) > i) for i in range(6)]
+    print("loss bursts of 1 / 2 / 3-4 / 5-8 / 9-16 / 17+: " + " / ".join(map(str, hist)))
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,88 @@
+"""
+Measure how long the device spends reconfiguring the radio per settings update.
+
+Sends a series of SETTINGS packets that each change one thing: nothing, the
+spreading factor, the frequency within the same band and the frequency into
+another band. After each one it reads the device's reconfigure_time and
+image_calibrations counters. Only the radio commands for changed parameters
+are sent, and the image calibration only runs when the band changes, so the
+steps should differ clearly.
+
+Usage (from the repository root):
+    python testing/reconfigure-time.py COM7
+"""
+
+import argparse
+import os
+import sys
+import time
+
+sys.path.insert(0, os.path.join(os.path.dirname(__file__), ".."))
+
+from lora_tool.lora_device import LoRaDevice
+from lora_tool.serial_comm import open_serial_port
+from lora_tool.settings import update_settings
+
+BASE = dict(frequency=915.0, power=14, bandwidth=125.0, spreading_factor=7)
+
+STEPS = [
+    ("baseline", {}),
+    ("no change", {}),
+    ("spreading factor", dict(spreading_factor=9)),
+    ("same band", dict(frequency=925.0)),
+    ("other band", dict(frequency=868.0)),
+    ("back again", dict(frequency=915.0)),
+]
+
+
+def totals(stats):
+    """
+    Return the cumulative reconfigure time, reconfigurations and calibrations.
+    """
+    reconfigure = stats.get("reconfigure_time")
+    if reconfigure is None:
+        return 0, 0, stats.get("image_calibrations", 0)
+    return (
+        reconfigure.mean_us * reconfigure.samples,
+        reconfigure.samples,
+        stats.get("image_calibrations", 0),
+    )
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[1])
+    parser.add_argument("port")
+    args = parser.parse_args()
+
+    device = LoRaDevice(open_serial_port(args.port))
+    time.sleep(1)
+    device.negotiate_framing()
+
+    before = totals(device.request_stats() or {})
+    print("step              commands sent  time us  calibrated")
+    for name, change in STEPS:
+        settings = dict(BASE, **change)
+        update_settings(
+            device,
+            settings["frequency"],
+            settings["power"],
+            settings["bandwidth"],
+            settings["spreading_factor"],
+            5,
+            8,
+            True,
+            0xAB,
+        )
+        time.sleep(0.3)
+        after = totals(device.request_stats() or {})
+        sent = after[1] > before[1]
+        elapsed = after[0] - before[0] if sent else 0
+        print(
+            f"{name:<16}  {'yes' if sent else 'no':>13}  {elapsed:>7}  "
+            f"{'yes' if after[2] > before[2] else 'no':>10}"
+        )
+        before = after
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,73 @@
+"""
+Measure the receiver's RX_DONE interrupt -> startReceive() turnaround.
+
+Puts one device in RECEIVER state and has a second device send a fixed number
+of packets with the on-device periodic transmitter, then reads the receiver's
+rx_turnaround statistic, i.e. how long the radio is deaf after each packet, and
+how many packets were dropped because no capture slot was free. Run it once
+against a receiver built with -DRADIO_RX_IN_LOOP and once against the default
+radio-task build to compare.
+
+Usage (from the repository root):
+    python testing/rx-turnaround.py COM7 COM8 --count 500 --period-ms 50 --bytes 32
+"""
+
+import argparse
+import os
+import sys
+import time
+
+sys.path.insert(0, os.path.join(os.path.dirname(__file__), ".."))
+
+import proto.packet_pb2 as packet_pb2
+from lora_tool.lora_device import LoRaDevice
+from lora_tool.serial_comm import open_serial_port
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[1])
+    parser.add_argument("rx_port")
+    parser.add_argument("tx_port")
+    parser.add_argument("--count", type=int, default=500)
+    parser.add_argument("--period-ms", type=float, default=50.0)
+    parser.add_argument("--bytes", type=int, default=32)
+    args = parser.parse_args()
+
+    receiver = LoRaDevice(open_serial_port(args.rx_port))
+    transmitter = LoRaDevice(open_serial_port(args.tx_port))
+    time.sleep(1)
+    for device in (receiver, transmitter):
+        device.negotiate_framing()
+
+    receiver.change_state(packet_pb2.State.RECEIVER)
+    transmitter.change_state(packet_pb2.State.TRANSMITTER)
+    time.sleep(0.2)
+
+    tx_stats = transmitter.run_schedule(
+        int(args.period_ms * 1000), args.bytes, count=args.count
+    )
+    time.sleep(0.5)
+    rx_stats = receiver.request_stats() or {}
+
+    receiver.change_state(packet_pb2.State.STANDBY)
+    transmitter.change_state(packet_pb2.State.STANDBY)
+
+    if tx_stats is None:
+        print("Transmitter refused the schedule")
+        return
+    turnaround = rx_stats.get("rx_turnaround")
+    if turnaround is None or not turnaround.samples:
+        print("Receiver reported no packets")
+        return
+    print(
+        f"sent {tx_stats.get('sched_sent', 0)}, received {turnaround.samples}, "
+        f"dropped for want of a capture slot {rx_stats.get('rx_capture_dropped', 0)}"
+    )
+    print(
+        f"turnaround us: min {turnaround.min_us}  mean {turnaround.mean_us}  "
+        f"max {turnaround.max_us}  stddev {turnaround.stddev_us}"
+    )
+
+
+if __name__ == "__main__":
+    main()
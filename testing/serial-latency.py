@@ -0,0 +1,77 @@
+"""
+Benchmark host command -> radio transmit() latency over the serial link.
+
+Sends TRANSMISSION packets one at a time to a device in TRANSMITTER state and
+times each one until the transmit Log (emitted right after startTransmit) comes
+back. Run it once against a firmware built with -DSERIAL_RX_POLLING and once
+against the default event-driven build to compare the two RX paths.
+
+Usage (from the repository root):
+    python testing/serial-latency.py COM7 --count 500 --bytes 10
+"""
+
+import argparse
+import os
+import random
+import statistics
+import sys
+import time
+
+sys.path.insert(0, os.path.join(os.path.dirname(__file__), ".."))
+
+import proto.packet_pb2 as packet_pb2
+from lora_tool.lora_device import LoRaDevice
+from lora_tool.serial_comm import open_serial_port
+
+
+def percentile(samples, pct):
+    ordered = sorted(samples)
+    return ordered[min(len(ordered) - 1, int(len(ordered) * pct / 100))]
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[1])
+    parser.add_argument("port")
+    parser.add_argument("--count", type=int, default=200)
+    parser.add_argument("--bytes", type=int, default=10)
+    parser.add_argument("--cobs", action="store_true", help="negotiate COBS framing")
+    args = parser.parse_args()
+
+    device = LoRaDevice(open_serial_port(args.port))
+    time.sleep(1)
+    if args.cobs and not device.negotiate_framing():
+        print("Device did not acknowledge COBS framing")
+    device.change_state(packet_pb2.State.TRANSMITTER)
+    time.sleep(0.2)
+    device.ser.reset_input_buffer()
+
+    round_trips = []
+    for _ in range(args.count):
+        payload = bytes(random.getrandbits(8) for _ in range(args.bytes))
+        start = time.perf_counter()
+        device.send_transmission(payload, 0)
+        if device.wait_for_packet(packet_pb2.PacketType.LOG) is None:
+            print("Timed out waiting for transmit log")
+            continue
+        round_trips.append((time.perf_counter() - start) * 1e6)
+
+    stats = device.request_stats() or {}
+    device.change_state(packet_pb2.State.STANDBY)
+
+    if round_trips:
+        print(f"Host command -> transmit log ({len(round_trips)} samples, us):")
+        print(
+            f"  min {min(round_trips):.0f}  median {statistics.median(round_trips):.0f}  "
+            f"p95 {percentile(round_trips, 95):.0f}  max {max(round_trips):.0f}"
+        )
+    latency = stats.get("command_latency")
+    if latency is not None:
+        print("Device frame decoded -> transmit() (us):")
+        print(
+            f"  min {latency.min_us}  mean {latency.mean_us}  max {latency.max_us}  "
+            f"stddev {latency.stddev_us}  ({latency.samples} samples)"
+        )
+
+
+if __name__ == "__main__":
+    main()